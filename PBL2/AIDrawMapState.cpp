@@ -1,6 +1,7 @@
 ﻿#include "AIDrawMapState.h"
 #include "AISolvingState.h"
 #include "Game.h"
+#include "Grid.h"
 
 AIDrawMapState::AIDrawMapState(Game* game, int gridDim, int numColors)
     : GameState(game), mGridDim(gridDim), mNumColors(numColors)
@@ -8,21 +9,27 @@ AIDrawMapState::AIDrawMapState(Game* game, int gridDim, int numColors)
     mUI.init(mGame->getResources());
     mSelectedColor = PALETTE[0];
 
-    mCellSize = MAP_AREA_SIZE / mGridDim;
-    mMapOffsetX = (SCREEN_WIDTH - UI_PANEL_WIDTH - MAP_AREA_SIZE) / 2;
-    mMapOffsetY = (SCREEN_HEIGHT - MAP_AREA_SIZE) / 2;
-
     initUI();
     clearMap();
 }
 
+void AIDrawMapState::recalculateLayout() {
+    BoardShape shape = mGame->getBoardShape();
+    mTopology = (shape == SHAPE_MASKED)
+        ? Topology::createMasked(mGame->getFillDirection(), mGridDim, mMask)
+        : Topology::create(shape, mGame->getFillDirection(), mGridDim);
+    mCellSize = mTopology->fitCellSize(MAP_AREA_SIZE);
+    mMapOffsetX = (SCREEN_WIDTH - UI_PANEL_WIDTH - mTopology->getBoardWidth(mCellSize)) / 2;
+    mMapOffsetY = (SCREEN_HEIGHT - MAP_AREA_SIZE) / 2;
+}
+
 void AIDrawMapState::initUI() {
     int uiX = SCREEN_WIDTH - UI_PANEL_WIDTH;
     int uiW = UI_PANEL_WIDTH;
 
-    mUI.addButton("start_solving", { uiX + 25, 450, uiW - 50, 60 }, "ai_draw_start_solving", BUTTON_GREEN, BUTTON_HIGHLIGHT);
-    mUI.addButton("clear_map", { uiX + 25, 530, uiW - 50, 50 }, "ai_draw_clear_map", BUTTON_YELLOW, BUTTON_HIGHLIGHT);
-    mUI.addButton("back_to_setup", { uiX + 25, 600, uiW - 50, 50 }, "ai_draw_back_to_setup", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("start_solving", { uiX + 25, 450, uiW - 50, 60 }, TXT_AI_DRAW_START_SOLVING, BUTTON_GREEN, BUTTON_HIGHLIGHT);
+    mUI.addButton("clear_map", { uiX + 25, 530, uiW - 50, 50 }, TXT_AI_DRAW_CLEAR_MAP, BUTTON_YELLOW, BUTTON_HIGHLIGHT);
+    mUI.addButton("back_to_setup", { uiX + 25, 600, uiW - 50, 50 }, TXT_AI_DRAW_BACK_TO_SETUP, BUTTON_GRAY, BUTTON_HIGHLIGHT);
 
     mUI.updateButtonTexts();
 
@@ -44,23 +51,46 @@ void AIDrawMapState::initUI() {
 
 void AIDrawMapState::clearMap() {
     mDrawnGrid.assign(mGridDim, std::vector<SDL_Color>(mGridDim, mSelectedColor));
+    mMask.assign((size_t)mGridDim * mGridDim, 1);
+    recalculateLayout();
 }
 
-void AIDrawMapState::handlePaint(int mX, int mY) {
-    if (mCellSize == 0) return;
-    int gridX = (mX - mMapOffsetX) / mCellSize;
-    int gridY = (mY - mMapOffsetY) / mCellSize;
+bool AIDrawMapState::getCellCenter(int gx, int gy, int& x, int& y) const {
+    if (!mTopology->isActive(gx, gy)) return false;
+    x = mMapOffsetX + mTopology->getRowShift(gy, mCellSize) + gx * mCellSize + mCellSize / 2;
+    y = mMapOffsetY + gy * mCellSize + mCellSize / 2;
+    return true;
+}
 
-    if (gridX >= 0 && gridX < mGridDim && gridY >= 0 && gridY < mGridDim) {
-        mDrawnGrid[gridX][gridY] = mSelectedColor;
-    }
+bool AIDrawMapState::cellFromPoint(int mX, int mY, int& gx, int& gy) const {
+    int px = mX - mMapOffsetX, py = mY - mMapOffsetY;
+    if (mTopology->getShape() != SHAPE_MASKED) return mTopology->cellAt(px, py, mCellSize, gx, gy);
+    // Bàn có lỗ là ô vuông; ô đang là lỗ vẫn chọn được để tô lại
+    if (mCellSize <= 0 || px < 0 || py < 0) return false;
+    gx = px / mCellSize;
+    gy = py / mCellSize;
+    return gx < mGridDim && gy < mGridDim;
+}
+
+void AIDrawMapState::handlePaint(int mX, int mY, bool erase) {
+    int gridX, gridY;
+    if (!cellFromPoint(mX, mY, gridX, gridY)) return;
+
+    if (!erase) mDrawnGrid[gridX][gridY] = mSelectedColor;
+    if (mTopology->getShape() != SHAPE_MASKED) return;
+
+    // Chỉ dựng lại topology khi mặt nạ thực sự đổi (kéo chuột qua cùng một ô không tốn gì)
+    unsigned char& active = mMask[gridX * mGridDim + gridY];
+    if (active == (erase ? 0 : 1)) return;
+    active = erase ? 0 : 1;
+    recalculateLayout();
 }
 
 void AIDrawMapState::handleEvents(SDL_Event& e) {
     std::string action = mUI.handleEvents(e);
 
     if (action == "start_solving") {
-        mGame->changeState(new AISolvingState(mGame, mGridDim, mNumColors, true, mDrawnGrid));
+        mGame->changeState(new AISolvingState(mGame, mGridDim, mNumColors, true, std::move(mDrawnGrid), std::move(mTopology)));
     }
     else if (action == "clear_map") {
         clearMap();
@@ -76,10 +106,13 @@ void AIDrawMapState::handleEvents(SDL_Event& e) {
                 }
             }
         }
-        handlePaint(e.button.x, e.button.y);
+        handlePaint(e.button.x, e.button.y, e.button.button == SDL_BUTTON_RIGHT);
     }
     else if (e.type == SDL_MOUSEMOTION && (e.motion.state & SDL_BUTTON(SDL_BUTTON_LEFT))) {
-        handlePaint(e.motion.x, e.motion.y);
+        handlePaint(e.motion.x, e.motion.y, false);
+    }
+    else if (e.type == SDL_MOUSEMOTION && (e.motion.state & SDL_BUTTON(SDL_BUTTON_RIGHT))) {
+        handlePaint(e.motion.x, e.motion.y, true);
     }
 }
 
@@ -92,21 +125,19 @@ void AIDrawMapState::draw(SDL_Renderer* renderer) {
     SDL_SetRenderDrawColor(renderer, BG_COLOR.r, BG_COLOR.g, BG_COLOR.b, 255);
     SDL_RenderClear(renderer);
 
-    SDL_Rect cellRect = { 0, 0, mCellSize, mCellSize };
+    Grid::drawCells(renderer, mDrawnGrid, *mTopology, mMapOffsetX, mMapOffsetY, mCellSize);
+
+    // Khung từng ô theo đúng hình học của bàn cờ (hàng lệch của lục giác, bỏ qua lỗ)
+    mCellFrames.clear();
     for (int y = 0; y < mGridDim; ++y) {
         for (int x = 0; x < mGridDim; ++x) {
-            cellRect.x = mMapOffsetX + x * mCellSize;
-            cellRect.y = mMapOffsetY + y * mCellSize;
-            SDL_Color c = mDrawnGrid[x][y];
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, 255);
-            SDL_RenderFillRect(renderer, &cellRect);
+            if (!mTopology->isActive(x, y)) continue;
+            mCellFrames.push_back({ mMapOffsetX + mTopology->getRowShift(y, mCellSize) + x * mCellSize,
+                mMapOffsetY + y * mCellSize, mCellSize, mCellSize });
         }
     }
     SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
-    for (int i = 0; i <= mGridDim; ++i) {
-        SDL_RenderDrawLine(renderer, mMapOffsetX + i * mCellSize, mMapOffsetY, mMapOffsetX + i * mCellSize, mMapOffsetY + (mCellSize * mGridDim));
-        SDL_RenderDrawLine(renderer, mMapOffsetX, mMapOffsetY + i * mCellSize, mMapOffsetX + (mCellSize * mGridDim), mMapOffsetY + i * mCellSize);
-    }
+    SDL_RenderDrawRects(renderer, mCellFrames.data(), (int)mCellFrames.size());
 
     SDL_Rect uiArea = { SCREEN_WIDTH - UI_PANEL_WIDTH, 0, UI_PANEL_WIDTH, SCREEN_HEIGHT };
     SDL_SetRenderDrawColor(renderer, UI_BG_COLOR.r, UI_BG_COLOR.g, UI_BG_COLOR.b, 255);
@@ -116,9 +147,12 @@ void AIDrawMapState::draw(SDL_Renderer* renderer) {
 
     int uiCenterX = uiArea.x + uiArea.w / 2;
 
-    drawText(renderer, res->getText("ai_draw_title"), uiCenterX, 60, res->getFontUI(), TEXT_WHITE);
+    drawText(renderer, res->getText(TXT_AI_DRAW_TITLE), uiCenterX, 60, res->getFontUI(), TEXT_WHITE);
+    if (mTopology->getShape() == SHAPE_MASKED) {
+        drawText(renderer, res->getText(TXT_AI_DRAW_ERASE_HINT), uiCenterX, 100, res->getFontSmall(), TEXT_WHITE);
+    }
 
-    drawText(renderer, res->getText("ai_draw_palette"), uiCenterX, 140, res->getFontUI(), PALETTE[3]);
+    drawText(renderer, res->getText(TXT_AI_DRAW_PALETTE), uiCenterX, 140, res->getFontUI(), PALETTE[3]);
 
     for (int i = 0; i < (int)mPaletteRects.size(); ++i) {
         if (i < (int)PALETTE.size()) {
@@ -134,7 +168,7 @@ void AIDrawMapState::draw(SDL_Renderer* renderer) {
         }
     }
 
-    drawText(renderer, res->getText("ai_draw_selected_color"), uiCenterX, 320, res->getFontUI(), PALETTE[5]);
+    drawText(renderer, res->getText(TXT_AI_DRAW_SELECTED_COLOR), uiCenterX, 320, res->getFontUI(), PALETTE[5]);
     SDL_Rect selectedColorBox = { uiCenterX - 30, 360, 60, 60 };
     SDL_SetRenderDrawColor(renderer, mSelectedColor.r, mSelectedColor.g, mSelectedColor.b, 255);
     SDL_RenderFillRect(renderer, &selectedColorBox);
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "GameState.h"
 #include "UIManager.h"
+#include "Topology.h"
 
 class AIDrawMapState : public GameState {
 public:
@@ -10,17 +11,25 @@ public:
     virtual void handleEvents(SDL_Event& e) override;
     virtual void update() override;
     virtual void draw(SDL_Renderer* renderer) override;
+    virtual const char* getName() const override { return "AIDrawMapState"; }
+    virtual UIManager* getUI() override { return &mUI; }
+    virtual bool getCellCenter(int gx, int gy, int& x, int& y) const override;
 
 private:
     void initUI();
     void clearMap();
-    void handlePaint(int mX, int mY);
+    void handlePaint(int mX, int mY, bool erase);
+    bool cellFromPoint(int mX, int mY, int& gx, int& gy) const;
+    void recalculateLayout();
 
     UIManager mUI;
 
     int mGridDim;
     int mNumColors;
     std::vector<std::vector<SDL_Color>> mDrawnGrid;
+    std::vector<unsigned char> mMask; ///< Ô còn thuộc bàn cờ (chỉ dùng với SHAPE_MASKED), chỉ số x * dim + y.
+    TopologyRef mTopology;            ///< Dựng lại mỗi khi mMask đổi.
+    std::vector<SDL_Rect> mCellFrames; ///< Bộ đệm vẽ khung các ô.
 
     SDL_Color mSelectedColor;
     std::vector<SDL_Rect> mPaletteRects;
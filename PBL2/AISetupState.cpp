@@ -19,13 +19,14 @@ AISetupState::AISetupState(Game* game)
 
 // === 1. KHỞI TẠO CÁC ĐIỂM ===
 void AISetupState::initNetwork() {
+    Random& rng = mGame->getEffectsRandom();
     for (int i = 0; i < 40; ++i) { // 40 điểm
         Node n;
-        n.x = (float)(rand() % SCREEN_WIDTH);
-        n.y = (float)(rand() % SCREEN_HEIGHT);
+        n.x = (float)rng.nextInt(SCREEN_WIDTH);
+        n.y = (float)rng.nextInt(SCREEN_HEIGHT);
         // Tốc độ ngẫu nhiên chậm
-        n.vx = ((rand() % 100) - 50) / 50.0f; // -1.0 đến 1.0
-        n.vy = ((rand() % 100) - 50) / 50.0f;
+        n.vx = (rng.nextInt(100) - 50) / 50.0f; // -1.0 đến 1.0
+        n.vy = (rng.nextInt(100) - 50) / 50.0f;
         mNodes.push_back(n);
     }
 }
@@ -87,15 +88,15 @@ void AISetupState::initButtons() {
 
     for (int i = 0; i < 5; ++i) {
         std::string key = "size_" + std::to_string(gridSizes[i]);
-        std::string text = std::to_string(gridSizes[i]);
-        mUI.addButton(key, { startX + i * (sBtnW + sPad), 250, sBtnW, sBtnH }, text, PALETTE[i], BUTTON_HIGHLIGHT, TEXT_WHITE);
+        mUI.addButton(key, { startX + i * (sBtnW + sPad), 250, sBtnW, sBtnH }, TXT_NONE, PALETTE[i], BUTTON_HIGHLIGHT, TEXT_WHITE);
+        mUI.getButton(key)->setText(std::to_string(gridSizes[i]));
     }
 
-    mUI.addButton("custom", { startX, 320, sBtnW, sBtnH }, "ai_setup_custom", BUTTON_GRAY, BUTTON_HIGHLIGHT);
-    mUI.addButton("draw", { startX + sBtnW + sPad, 320, sBtnW * 2 + sPad, sBtnH }, "ai_setup_draw_map", BUTTON_BLUE, BUTTON_HIGHLIGHT);
+    mUI.addButton("custom", { startX, 320, sBtnW, sBtnH }, TXT_AI_SETUP_CUSTOM, BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("draw", { startX + sBtnW + sPad, 320, sBtnW * 2 + sPad, sBtnH }, TXT_AI_SETUP_DRAW_MAP, BUTTON_BLUE, BUTTON_HIGHLIGHT);
 
-    mUI.addButton("start_random", { (SCREEN_WIDTH - 250) / 2, 500, 250, 60 }, "ai_setup_start", BUTTON_GREEN, BUTTON_HIGHLIGHT);
-    mUI.addButton("back", { (SCREEN_WIDTH - 200) / 2, 600, 200, 60 }, "ai_setup_back", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("start_random", { (SCREEN_WIDTH - 250) / 2, 500, 250, 60 }, TXT_AI_SETUP_START, BUTTON_GREEN, BUTTON_HIGHLIGHT);
+    mUI.addButton("back", { (SCREEN_WIDTH - 200) / 2, 600, 200, 60 }, TXT_AI_SETUP_BACK, BUTTON_GRAY, BUTTON_HIGHLIGHT);
 
     mUI.updateButtonTexts();
 }
@@ -184,8 +185,8 @@ void AISetupState::draw(SDL_Renderer* renderer) {
     // === VẼ NỀN TRANG TRÍ ===
     drawNetwork(renderer);
 
-    drawText(renderer, res->getText("ai_setup_title"), SCREEN_WIDTH / 2, 80, fontTitle, PALETTE[2]);
-    drawText(renderer, res->getText("ai_setup_grid_size"), SCREEN_WIDTH / 2, 200, fontUI, TEXT_WHITE);
+    drawText(renderer, res->getText(TXT_AI_SETUP_TITLE), SCREEN_WIDTH / 2, 80, fontTitle, PALETTE[2]);
+    drawText(renderer, res->getText(TXT_AI_SETUP_GRID_SIZE), SCREEN_WIDTH / 2, 200, fontUI, TEXT_WHITE);
 
     mUI.getButton("size_10")->draw(renderer, fontUI, mAiGridDim == 10);
     mUI.getButton("size_14")->draw(renderer, fontUI, mAiGridDim == 14);
@@ -217,7 +218,7 @@ void AISetupState::drawCustomInputOverlay(SDL_Renderer* renderer) {
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_RenderDrawRect(renderer, &box);
 
-    drawText(renderer, res->getText("ai_custom_prompt"), box.x + box.w / 2, box.y + 40, res->getFontUI(), TEXT_WHITE);
+    drawText(renderer, res->getText(TXT_AI_CUSTOM_PROMPT), box.x + box.w / 2, box.y + 40, res->getFontUI(), TEXT_WHITE);
 
     SDL_Rect inputBox = { box.x + 50, box.y + 90, box.w - 100, 50 };
     SDL_SetRenderDrawColor(renderer, BG_COLOR.r, BG_COLOR.g, BG_COLOR.b, 255);
@@ -227,5 +228,5 @@ void AISetupState::drawCustomInputOverlay(SDL_Renderer* renderer) {
     if (SDL_GetTicks() % 1000 < 500) displayText += "_";
 
     drawText(renderer, displayText, inputBox.x + inputBox.w / 2, inputBox.y + inputBox.h / 2, res->getFontUI(), TEXT_WHITE);
-    drawText(renderer, res->getText("ai_custom_confirm"), box.x + box.w / 2, box.y + box.h - 25, res->getFontSmall(), { 200, 200, 200, 255 });
+    drawText(renderer, res->getText(TXT_AI_CUSTOM_CONFIRM), box.x + box.w / 2, box.y + box.h - 25, res->getFontSmall(), { 200, 200, 200, 255 });
 }
\ No newline at end of file
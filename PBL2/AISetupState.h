@@ -18,6 +18,8 @@ public:
     virtual void handleEvents(SDL_Event& e) override;
     virtual void update() override;
     virtual void draw(SDL_Renderer* renderer) override;
+    virtual const char* getName() const override { return "AISetupState"; }
+    virtual UIManager* getUI() override { return &mUI; }
 
 private:
     void initButtons();
@@ -3,9 +3,43 @@
 #include "Constants.h"
 #include "Grid.h"
 #include "ResourceManager.h"
+#include "SnapshotBuffer.h"
+#include <atomic>
 #include <chrono>
-#include <queue>
-#include <stack>
+#include <thread>
+
+/**
+ * @struct AISolverStats
+ * @brief Số đo hiệu năng thuần của một AI solver, tách khỏi thời gian chờ hiệu ứng.
+ *
+ * Thời gian chỉ cộng phần CPU thực sự dùng để chọn nước đi và tô màu, nên có thể
+ * so sánh trực tiếp BFS, DFS, Scanline và Union-Find.
+ */
+struct AISolverStats {
+    double selectTime = 0.0;     ///< Tổng thời gian chọn nước đi (giây).
+    double fillTime = 0.0;       ///< Tổng thời gian tô màu (giây).
+    FloodFill::FillStats fill;   ///< Bộ đếm của kernel tô màu (ô đã duyệt, lần lấy thừa, đỉnh container, cấp phát).
+};
+
+/**
+ * @struct AISolverStatus
+ * @brief Tiến trình của một AI solver tại một thời điểm, trả về theo giá trị cho luồng vẽ.
+ */
+struct AISolverStatus {
+    int moves = 0;                             ///< Số bước đi đã thực hiện.
+    double elapsedTime = 0.0;                  ///< Thời gian đã trôi qua (giây).
+    bool done = false;                         ///< Đã giải xong hay chưa.
+    AISolverStats stats;                       ///< Số đo hiệu năng.
+};
+
+/**
+ * @struct AISolverSnapshot
+ * @brief Ảnh chụp trạng thái của một AI solver mà luồng worker publish cho luồng vẽ.
+ */
+struct AISolverSnapshot {
+    std::vector<std::vector<SDL_Color>> cells; ///< Lưới tại thời điểm chụp.
+    AISolverStatus status;                     ///< Tiến trình tại thời điểm chụp.
+};
 
 /**
  * @class AISolver
@@ -13,6 +47,8 @@
  *
  * Lớp này quản lý logic của AI, bao gồm việc chọn nước đi tiếp theo,
  * thực hiện thuật toán tô màu (BFS, DFS, Scanline), và theo dõi tiến trình giải đố.
+ * Việc tô và chọn nước đi đều đi qua Grid, dùng chung kernel trong FloodFill.h với người chơi.
+ * Mỗi solver chạy trên một luồng worker riêng; luồng vẽ chỉ đọc ảnh chụp qua SnapshotBuffer.
  */
 class AISolver {
 public:
@@ -22,24 +58,34 @@ public:
     AISolver();
 
     /**
-     * @brief Khởi tạo AI solver với một thuật toán, hướng tô, bản đồ và số màu cụ thể.
+     * @brief Hàm hủy, dừng luồng worker nếu đang chạy.
+     */
+    ~AISolver();
+
+    AISolver(const AISolver&) = delete;
+    AISolver& operator=(const AISolver&) = delete;
+
+    /**
+     * @brief Khởi tạo AI solver với một thuật toán, dạng bàn cờ, bản đồ và số màu cụ thể.
      * @param algo Loại thuật toán sẽ sử dụng (BFS, DFS, Scanline).
-     * @param fillDir Hướng tô (4 hướng hoặc 8 hướng).
-     * @param masterGrid Trạng thái ban đầu của lưới.
+     * @param topology Dạng bàn cờ và hướng tô, dùng chung giữa các solver.
+     * @param masterGrid Trạng thái ban đầu của lưới, dùng chung giữa các solver (mỗi solver chỉ sao chép một lần để tô).
      * @param numColors Số lượng màu sắc có trong màn chơi.
      */
-    void init(AlgorithmType algo, FillDirection fillDir, const std::vector<std::vector<SDL_Color>>& masterGrid, int numColors);
+    void init(AlgorithmType algo, TopologyRef topology, const BoardSnapshot& masterGrid, int numColors);
 
     /**
-     * @brief Cập nhật trạng thái của AI solver.
-     *
-     * Nếu chưa hoàn thành, nó sẽ tìm nước đi tốt nhất và bắt đầu tô màu.
-     * Nếu đang trong quá trình tô màu, nó sẽ tiếp tục hiệu ứng tô màu.
+     * @brief Khởi động luồng worker giải màn chơi (gọi sau init()).
      */
-    void update();
+    void start();
 
     /**
-     * @brief Vẽ trạng thái hiện tại của lưới và thông tin của AI solver.
+     * @brief Yêu cầu luồng worker dừng và chờ nó kết thúc.
+     */
+    void stop();
+
+    /**
+     * @brief Vẽ ảnh chụp mới nhất của lưới và thông tin của AI solver (chỉ gọi từ luồng vẽ).
      * @param renderer Con trỏ tới SDL_Renderer.
      * @param viewport Hình chữ nhật xác định khu vực vẽ.
      * @param font Font chữ để hiển thị thông tin chính.
@@ -55,70 +101,53 @@ public:
     std::string getName() const;
 
     /**
-     * @brief Lấy số bước đi mà AI đã thực hiện.
-     * @return Số bước đi.
-     */
-    int getMoves() const { return mMoves; }
-
-    /**
-     * @brief Lấy thời gian đã trôi qua kể từ khi AI bắt đầu giải.
-     * @return Thời gian đã trôi qua (tính bằng giây).
-     */
-    double getElapsedTime() const { return mElapsedTime.count(); }
-
-    /**
-     * @brief Kiểm tra xem AI đã giải xong chưa.
-     * @return true nếu đã giải xong, false nếu chưa.
+     * @brief Lấy tiến trình theo ảnh chụp mới nhất (chỉ gọi từ luồng vẽ).
+     *
+     * Đọc bộ đệm ảnh chụp một lần và trả về bản sao, nên số bước, thời gian, cờ xong và số đo
+     * luôn thuộc cùng một ảnh. Người gọi nên lấy một lần mỗi khung hình rồi dùng bản sao đó.
+     * @return Bản sao tiến trình (không tham chiếu vào vùng nhớ của bộ đệm).
      */
-    bool isDone() const { return mIsDone; }
+    AISolverStatus getStatus() const { return mSnapshots.read().status; }
 
 private:
     /**
-     * @brief Tìm màu tiếp theo tốt nhất để tô.
-     *
-     * Thuật toán này đánh giá mỗi màu có thể chọn và trả về màu mở rộng vùng được tô nhiều nhất.
-     * @return Màu tốt nhất để chọn cho nước đi tiếp theo.
+     * @brief Vòng lặp của luồng worker: mỗi nhịp gọi update() rồi publish ảnh chụp.
      */
-    SDL_Color findBestNextMove() const;
+    void run();
 
     /**
-     * @brief Bắt đầu quá trình tô màu loang (flood fill) với một màu mới.
-     * @param newColor Màu sẽ được dùng để tô.
+     * @brief Cập nhật trạng thái của AI solver (chạy trên luồng worker).
+     *
+     * Nếu chưa hoàn thành, nó sẽ tìm nước đi tốt nhất và bắt đầu tô màu.
+     * Nếu đang trong quá trình tô màu, nó sẽ tiếp tục hiệu ứng tô màu.
      */
-    void startFloodFill(const SDL_Color& newColor);
+    void update();
 
     /**
-     * @brief Thực hiện một bước của hiệu ứng tô màu.
+     * @brief Ghi trạng thái hiện tại vào bộ đệm ảnh chụp và publish cho luồng vẽ.
      */
-    void animateFillStep();
+    void publishSnapshot();
 
     /**
      * @brief Kiểm tra xem toàn bộ lưới đã được tô cùng một màu chưa (điều kiện thắng).
      */
     void checkWinCondition();
 
-    /**
-     * @brief Đếm số ô trong vùng được kết nối bắt đầu từ (0,0).
-     * @param grid Lưới để kiểm tra.
-     * @param fillDir Hướng kết nối (4 hoặc 8).
-     * @return Số lượng ô trong vùng được kết nối.
-     */
-    static int countConnectedRegion(const std::vector<std::vector<SDL_Color>>& grid, FillDirection fillDir);
-
     Grid mGrid;                     ///< Lưới game mà AI đang giải.
     AlgorithmType mAlgoType;        ///< Loại thuật toán đang sử dụng.
-    FillDirection mFillDir;         ///< Hướng tô màu (4 hoặc 8 hướng).
+    TopologyRef mTopology;          ///< Dạng bàn cờ (không đổi sau init() nên luồng vẽ đọc được).
     int mNumColors;                 ///< Số lượng màu trong màn chơi.
 
     int mMoves;                     ///< Số bước đi đã thực hiện.
     bool mIsDone;                   ///< Cờ báo hiệu đã giải xong.
-    bool mIsAnimating;              ///< Cờ báo hiệu đang trong hiệu ứng tô màu.
 
     std::chrono::steady_clock::time_point mStartTime; ///< Thời điểm bắt đầu giải.
     std::chrono::duration<double> mElapsedTime;       ///< Thời gian đã trôi qua.
 
-    SDL_Color mTargetColor, mReplacementColor; ///< Màu mục tiêu và màu thay thế cho thuật toán tô màu.
-    std::queue<std::pair<int, int>> mBfsQueue;   ///< Hàng đợi cho thuật toán BFS.
-    std::stack<std::pair<int, int>> mDfsStack;   ///< Ngăn xếp cho thuật toán DFS.
-    std::stack<std::pair<int, int>> mScanlineStack; ///< Ngăn xếp cho thuật toán Scanline.
+    AISolverStats mStats;           ///< Số đo hiệu năng tích lũy.
+
+    std::thread mWorker;                 ///< Luồng chạy thuật toán.
+    std::atomic<bool> mStopRequested;    ///< Cờ yêu cầu luồng worker dừng.
+    mutable SnapshotBuffer<AISolverSnapshot> mSnapshots; ///< Ảnh chụp cho luồng vẽ.
+    MemoryCharge mSnapshotCharge;        ///< Ước tính ba bản sao lưới trong mSnapshots.
 };
\ No newline at end of file
@@ -2,33 +2,56 @@
 #include "MainMenuState.h"
 #include "AISetupState.h"
 #include "Game.h"
-#include <cstdlib>
-AISolvingState::AISolvingState(Game* game, int gridDim, int numColors, bool useDrawnGrid, const std::vector<std::vector<SDL_Color>>& drawnGrid)
-    : GameState(game)
+#include "MemoryStats.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+AISolvingState::AISolvingState(Game* game, int gridDim, int numColors, bool useDrawnGrid, std::vector<std::vector<SDL_Color>> drawnGrid,
+    TopologyRef drawnTopology)
+    : GameState(game), mGridDim(useDrawnGrid ? (int)drawnGrid.size() : gridDim), mNumColors(numColors), mStatsExported(false)
 {
+    // Đỉnh bộ nhớ trong ai_benchmark.txt chỉ tính từ lần chạy này
+    MemoryStats::resetPeaks();
+
     std::vector<std::vector<SDL_Color>> masterGrid;
+    uint64_t mapSeed = 0;
     if (useDrawnGrid) {
-        masterGrid = drawnGrid;
+        masterGrid = std::move(drawnGrid);
     }
     else {
-        generateMap(masterGrid, gridDim, numColors);
+        mapSeed = mGame->nextAIMapSeed();
+        std::cout << "AI map seed: " << mapSeed << std::endl;
+        Random rng(mapSeed);
+        generateMap(masterGrid, gridDim, numColors, rng);
     }
 
-    FillDirection fillDir = mGame->getFillDirection();
+    if (drawnTopology && drawnTopology->getDim() == mGridDim) {
+        mTopology = std::move(drawnTopology);
+    }
+    else {
+        mTopology = Topology::create(mGame->getBoardShape(), mGame->getFillDirection(), mGridDim, mapSeed);
+    }
 
-    mSolvers[0].init(ALGO_BFS, fillDir, masterGrid, numColors);
-    mSolvers[1].init(ALGO_DFS, fillDir, masterGrid, numColors);
-    mSolvers[2].init(ALGO_SCANLINE, fillDir, masterGrid, numColors);
-    mSolvers[3].init(ALGO_UNION_FIND, fillDir, masterGrid, numColors);
+    // Bốn solver đọc chung một lưới ban đầu và một topology; mỗi solver chỉ giữ bản sao lưới để tô
+    BoardSnapshot master = makeBoardSnapshot(std::move(masterGrid));
+    mSolvers[0].init(ALGO_BFS, mTopology, master, numColors);
+    mSolvers[1].init(ALGO_DFS, mTopology, master, numColors);
+    mSolvers[2].init(ALGO_SCANLINE, mTopology, master, numColors);
+    mSolvers[3].init(ALGO_UNION_FIND, mTopology, master, numColors);
+
+    // Mỗi solver chạy trên luồng riêng; update()/draw() của state chỉ đọc ảnh chụp
+    for (int i = 0; i < 4; ++i) {
+        mSolvers[i].start();
+    }
 
     initUI();
 }
 
-void AISolvingState::generateMap(std::vector<std::vector<SDL_Color>>& grid, int dim, int numColors) {
+void AISolvingState::generateMap(std::vector<std::vector<SDL_Color>>& grid, int dim, int numColors, Random& rng) {
     grid.assign(dim, std::vector<SDL_Color>(dim));
     for (int y = 0; y < dim; ++y) {
         for (int x = 0; x < dim; ++x) {
-            grid[x][y] = PALETTE[rand() % numColors];
+            grid[x][y] = PALETTE[rng.nextInt(numColors)];
         }
     }
 }
@@ -40,9 +63,9 @@ void AISolvingState::initUI() {
     int btn_h = 50;
     int bottom_panel_y = SCREEN_HEIGHT - bottom_panel_height + (bottom_panel_height - btn_h) / 2;
 
-    mUI.addButton("new_map", { SCREEN_WIDTH / 2 - 220, bottom_panel_y, 200, btn_h }, "ai_solving_new_map", BUTTON_BLUE, BUTTON_HIGHLIGHT);
+    mUI.addButton("new_map", { SCREEN_WIDTH / 2 - 220, bottom_panel_y, 200, btn_h }, TXT_AI_SOLVING_NEW_MAP, BUTTON_BLUE, BUTTON_HIGHLIGHT);
 
-    mUI.addButton("menu", { SCREEN_WIDTH / 2 + 20, bottom_panel_y, 200, btn_h }, "ai_solving_menu", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("menu", { SCREEN_WIDTH / 2 + 20, bottom_panel_y, 200, btn_h }, TXT_AI_SOLVING_MENU, BUTTON_GRAY, BUTTON_HIGHLIGHT);
 
     mUI.updateButtonTexts();
 }
@@ -59,8 +82,35 @@ void AISolvingState::handleEvents(SDL_Event& e) {
 }
 
 void AISolvingState::update() {
+    if (mStatsExported) return;
     for (int i = 0; i < 4; ++i) {
-        mSolvers[i].update();
+        if (!mSolvers[i].getStatus().done) return;
+    }
+    exportStats();
+    mStatsExported = true;
+}
+
+void AISolvingState::exportStats() const {
+    std::ofstream statsFile("ai_benchmark.txt", std::ios::app);
+    if (!statsFile.is_open()) {
+        std::cerr << "Không thể ghi ai_benchmark.txt!" << std::endl;
+        return;
+    }
+    statsFile << "# dim=" << mGridDim << " colors=" << mNumColors
+        << " dir=" << (mTopology->getFillDirection() == DIR_FOUR ? 4 : 8)
+        << " shape=" << Topology::getShapeName(mTopology->getShape()) << " cells=" << mTopology->getCellCount() << "\n";
+    statsFile << "algo,moves,select_ms,fill_ms,cells_visited,redundant_pops,peak_container,allocations\n";
+    for (int i = 0; i < 4; ++i) {
+        AISolverStatus status = mSolvers[i].getStatus();
+        const AISolverStats& stats = status.stats;
+        statsFile << mSolvers[i].getName() << "," << status.moves << ","
+            << std::fixed << std::setprecision(3) << stats.selectTime * 1000.0 << "," << stats.fillTime * 1000.0 << ","
+            << stats.fill.cellsVisited << "," << stats.fill.redundantPops << "," << stats.fill.peakContainer << "," << stats.fill.allocations << "\n";
+    }
+    statsFile << "memory,current_bytes,peak_bytes\n";
+    for (int i = 0; i < MEM_TAG_COUNT; ++i) {
+        MemoryTag tag = (MemoryTag)i;
+        statsFile << MemoryStats::getTagName(tag) << "," << MemoryStats::getCurrent(tag) << "," << MemoryStats::getPeak(tag) << "\n";
     }
 }
 
@@ -5,17 +5,29 @@
 
 class AISolvingState : public GameState {
 public:
-    AISolvingState(Game* game, int gridDim, int numColors, bool useDrawnGrid, const std::vector<std::vector<SDL_Color>>& drawnGrid);
+    /**
+     * @param drawnGrid Map tự vẽ, nhận theo giá trị để caller chuyển (std::move) vào thay vì sao chép.
+     * @param drawnTopology Dạng bàn cờ của map tự vẽ (có thể có lỗ); nullptr thì dùng dạng trong cài đặt.
+     */
+    AISolvingState(Game* game, int gridDim, int numColors, bool useDrawnGrid, std::vector<std::vector<SDL_Color>> drawnGrid,
+        TopologyRef drawnTopology = nullptr);
     virtual ~AISolvingState() {}
 
     virtual void handleEvents(SDL_Event& e) override;
     virtual void update() override;
     virtual void draw(SDL_Renderer* renderer) override;
+    virtual const char* getName() const override { return "AISolvingState"; }
+    virtual UIManager* getUI() override { return &mUI; }
 
 private:
     void initUI();
-    void generateMap(std::vector<std::vector<SDL_Color>>& grid, int dim, int numColors);
+    void generateMap(std::vector<std::vector<SDL_Color>>& grid, int dim, int numColors, Random& rng);
+    void exportStats() const;
 
     UIManager mUI;
     AISolver mSolvers[4];
+    int mGridDim;
+    int mNumColors;
+    TopologyRef mTopology;
+    bool mStatsExported;
 };
\ No newline at end of file
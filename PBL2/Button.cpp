@@ -1,13 +1,13 @@
 ﻿#include "Button.h"
 
 Button::Button()
-    : mRect({ 0, 0, 0, 0 }), mTextKey(""), mText(""), mColor({ 0,0,0,0 }),
+    : mRect({ 0, 0, 0, 0 }), mTextId(TXT_NONE), mText(""), mColor({ 0,0,0,0 }),
     mHighlightColor({ 0,0,0,0 }), mTextColor(TEXT_WHITE), mIsPressed(false)
 {
 }
 
-Button::Button(SDL_Rect rect, std::string textKey, std::string text, SDL_Color color, SDL_Color highlightColor, SDL_Color textColor)
-    : mRect(rect), mTextKey(textKey), mText(text), mColor(color),
+Button::Button(SDL_Rect rect, TextId textId, std::string text, SDL_Color color, SDL_Color highlightColor, SDL_Color textColor)
+    : mRect(rect), mTextId(textId), mText(text), mColor(color),
     mHighlightColor(highlightColor), mTextColor(textColor), mIsPressed(false)
 {
 }
@@ -71,12 +71,12 @@ void Button::setText(const std::string& text) {
     mText = text;
 }
 
-void Button::setTextKey(const std::string& key) {
-    mTextKey = key;
+void Button::setTextId(TextId id) {
+    mTextId = id;
 }
 
-const std::string& Button::getTextKey() const {
-    return mTextKey;
+TextId Button::getTextId() const {
+    return mTextId;
 }
 
 const SDL_Rect& Button::getRect() const {
@@ -2,12 +2,13 @@
 
 #include <SDL_ttf.h>
 #include "Constants.h"
+#include "TextId.h"
 #include <algorithm> // Cho std::max
 
 class Button {
 private:
     SDL_Rect mRect;
-    std::string mTextKey;
+    TextId mTextId;
     std::string mText;
     SDL_Color mColor;
     SDL_Color mHighlightColor;
@@ -27,14 +28,14 @@ private:
 
 public:
     Button();
-    Button(SDL_Rect rect, std::string textKey, std::string text, SDL_Color color, SDL_Color highlightColor, SDL_Color textColor = TEXT_WHITE);
+    Button(SDL_Rect rect, TextId textId, std::string text, SDL_Color color, SDL_Color highlightColor, SDL_Color textColor = TEXT_WHITE);
 
     void draw(SDL_Renderer* renderer, TTF_Font* font, bool highlighted = false);
     bool isClicked(int x, int y) const;
 
     void setText(const std::string& text);
-    void setTextKey(const std::string& key);
-    const std::string& getTextKey() const;
+    void setTextId(TextId id);
+    TextId getTextId() const;
     const SDL_Rect& getRect() const;
 
     void setPressed(bool pressed) { mIsPressed = pressed; }
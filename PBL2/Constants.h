@@ -2,7 +2,10 @@
 
 #include <SDL.h>
 #include <SDL_ttf.h> 
+#include "MemoryStats.h"
+#include "Trace.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <set>
@@ -28,6 +31,7 @@ enum AppState {
 
 enum AlgorithmType { ALGO_BFS, ALGO_DFS, ALGO_SCANLINE, ALGO_UNION_FIND };
 enum FillDirection { DIR_FOUR, DIR_EIGHT };
+enum BoardShape { SHAPE_SQUARE, SHAPE_TORUS, SHAPE_HEX, SHAPE_MASKED };
 enum Language { LANG_VI, LANG_EN, LANG_CN, LANG_JP };
 enum GameDifficulty { DIFF_EASY, DIFF_NORMAL, DIFF_HARD };
 
@@ -43,7 +47,24 @@ enum IllustrationType {
     ILLUST_AI           // Trang 8: AI
 };
 
-const int STEPS_PER_FRAME = 10;
+// Thời lượng hoạt ảnh phát lại một lần tô (xem FillPacer); lưới đã tô xong trước khi hoạt ảnh chạy
+const double FILL_ANIMATION_MS = 600.0;     // Thời lượng mục tiêu một lần phát của người chơi
+const double FILL_FRAME_BUDGET_MS = 4.0;    // Thời gian phát tối đa mỗi khung hình
+const double AI_FILL_ANIMATION_MS = 250.0;  // Thời lượng mục tiêu một lần phát của AI solver
+const double AI_FILL_TICK_BUDGET_MS = 8.0;  // Thời gian phát tối đa mỗi nhịp AI (nửa AI_SOLVER_TICK_MS)
+const int MAX_HINT_DEPTH = 4; // Số bước nhìn trước tối đa của gợi ý tính nền
+const int AI_SOLVER_TICK_MS = 16; // Nhịp của mỗi luồng AI solver (~60 bước/giây)
+
+// Giải thử màn chơi khi sinh để đặt giới hạn số bước
+const int CALIBRATION_SYNC_MAX_CELLS = 256;   // Màn nhỏ hơn: giải ngay trong khung hình
+// Ngân sách tính theo số nút × số ô của lưới (xem LevelCalibrator::nodeBudgetForWork), ~50 ns mỗi đơn vị
+const long long CALIBRATION_SYNC_WORK = 160000;    // Khi giải ngay (~8 ms, nửa khung hình 60 FPS)
+const long long CALIBRATION_ASYNC_WORK = 8000000;  // Khi giải trên luồng nền (~400 ms)
+const int CALIBRATION_MAX_DEPTH = 3;          // Số bước nhìn trước tối đa khi giải thử
+
+const char* const LEVEL_PACK_FILE = "levels.pack"; // Các màn sinh sẵn (tạo bằng --build-level-pack)
+const char* const STARTUP_LOG_FILE = "startup_times.txt"; // Mỗi lần khởi động ghi thêm một dòng thời gian từng giai đoạn
+const char* const DEFAULT_FONT_FILE = "Baloo2-Bold.ttf";
 
 struct PredictionResult {
     bool possibleToWin = true;
@@ -88,28 +109,45 @@ inline bool areColorsEqual(const SDL_Color& c1, const SDL_Color& c2) {
     return c1.r == c2.r && c1.g == c2.g && c1.b == c2.b;
 }
 
-inline void drawText(SDL_Renderer* renderer, const std::string& text, int cX, int cY, TTF_Font* f, SDL_Color c) {
+// Vị trí của màu trong PALETTE, -1 nếu màu không thuộc bảng màu
+inline int getPaletteIndex(const SDL_Color& c) {
+    for (int i = 0; i < (int)PALETTE.size(); ++i) {
+        if (areColorsEqual(PALETTE[i], c)) return i;
+    }
+    return -1;
+}
+
+// Các hàm vẽ chữ nhận string_view nhưng truyền thẳng data() cho SDL_ttf, nên chuỗi phải kết thúc bằng NUL
+// (std::string, chuỗi hằng và bảng dịch của ResourceManager đều thỏa; không truyền substr của string_view).
+// Texture chữ chỉ sống trong một lần vẽ; nó vẫn được tính vào MEM_TEXTURES để hiện trong số đỉnh.
+inline void drawText(SDL_Renderer* renderer, std::string_view text, int cX, int cY, TTF_Font* f, SDL_Color c) {
     if (!f || text.empty() || !renderer) return;
-    SDL_Surface* s = TTF_RenderUTF8_Blended(f, text.c_str(), c); if (!s) return;
+    TRACE_SCOPE("drawText");
+    SDL_Surface* s = TTF_RenderUTF8_Blended(f, text.data(), c); if (!s) return;
     SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s); if (!t) { SDL_FreeSurface(s); return; }
+    MemoryCharge textureCharge(MEM_TEXTURES); textureCharge.set((size_t)s->w * s->h * 4);
     SDL_Rect dR = { cX - s->w / 2, cY - s->h / 2, s->w, s->h };
     SDL_RenderCopy(renderer, t, NULL, &dR);
     SDL_FreeSurface(s); SDL_DestroyTexture(t);
 }
 
-inline void drawTextLeft(SDL_Renderer* renderer, const std::string& text, int cX, int cY, TTF_Font* f, SDL_Color c) {
+inline void drawTextLeft(SDL_Renderer* renderer, std::string_view text, int cX, int cY, TTF_Font* f, SDL_Color c) {
     if (!f || text.empty() || !renderer) return;
-    SDL_Surface* s = TTF_RenderUTF8_Blended(f, text.c_str(), c); if (!s) return;
+    TRACE_SCOPE("drawText");
+    SDL_Surface* s = TTF_RenderUTF8_Blended(f, text.data(), c); if (!s) return;
     SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s); if (!t) { SDL_FreeSurface(s); return; }
+    MemoryCharge textureCharge(MEM_TEXTURES); textureCharge.set((size_t)s->w * s->h * 4);
     SDL_Rect dR = { cX, cY - s->h / 2, s->w, s->h };
     SDL_RenderCopy(renderer, t, NULL, &dR);
     SDL_FreeSurface(s); SDL_DestroyTexture(t);
 }
 
-inline void drawTextRight(SDL_Renderer* renderer, const std::string& text, int cX, int cY, TTF_Font* f, SDL_Color c) {
+inline void drawTextRight(SDL_Renderer* renderer, std::string_view text, int cX, int cY, TTF_Font* f, SDL_Color c) {
     if (!f || text.empty() || !renderer) return;
-    SDL_Surface* s = TTF_RenderUTF8_Blended(f, text.c_str(), c); if (!s) return;
+    TRACE_SCOPE("drawText");
+    SDL_Surface* s = TTF_RenderUTF8_Blended(f, text.data(), c); if (!s) return;
     SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s); if (!t) { SDL_FreeSurface(s); return; }
+    MemoryCharge textureCharge(MEM_TEXTURES); textureCharge.set((size_t)s->w * s->h * 4);
     SDL_Rect dR = { cX - s->w, cY - s->h / 2, s->w, s->h };
     SDL_RenderCopy(renderer, t, NULL, &dR);
     SDL_FreeSurface(s); SDL_DestroyTexture(t);
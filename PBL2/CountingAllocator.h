@@ -0,0 +1,49 @@
+﻿#pragma once
+
+#include "MemoryStats.h"
+#include <cstddef>
+#include <new>
+
+/**
+ * @class CountingAllocator
+ * @brief Allocator đếm số lần cấp phát vào một bộ đếm bên ngoài.
+ *
+ * Dùng cho các container của thuật toán tô màu để đo số lần cấp phát bộ nhớ
+ * mà không phải thay operator new toàn cục. Số byte đang giữ được cộng vào MEM_FILL_CONTAINERS.
+ */
+template <typename T>
+class CountingAllocator {
+public:
+    using value_type = T;
+
+    explicit CountingAllocator(long long* counter = nullptr) : mCounter(counter) {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : mCounter(other.getCounter()) {}
+
+    T* allocate(std::size_t n) {
+        if (mCounter) ++*mCounter;
+        MemoryStats::add(MEM_FILL_CONTAINERS, (long long)(n * sizeof(T)));
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        MemoryStats::add(MEM_FILL_CONTAINERS, -(long long)(n * sizeof(T)));
+        ::operator delete(p);
+    }
+
+    long long* getCounter() const { return mCounter; }
+
+private:
+    long long* mCounter;
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>& a, const CountingAllocator<U>& b) {
+    return a.getCounter() == b.getCounter();
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>& a, const CountingAllocator<U>& b) {
+    return !(a == b);
+}
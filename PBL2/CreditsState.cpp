@@ -1,6 +1,5 @@
 ﻿#include "CreditsState.h"
 #include "Game.h"
-#include <cstdlib> 
 
 CreditsState::CreditsState(Game* game) : GameState(game) {
     mUI.init(mGame->getResources());
@@ -12,7 +11,7 @@ CreditsState::CreditsState(Game* game) : GameState(game) {
 }
 
 void CreditsState::initButtons() {
-    mUI.addButton("back", { SCREEN_WIDTH / 2 - 100, 620, 200, 60 }, "settings_back", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("back", { SCREEN_WIDTH / 2 - 100, 620, 200, 60 }, TXT_SETTINGS_BACK, BUTTON_GRAY, BUTTON_HIGHLIGHT);
     mUI.updateButtonTexts();
 }
 
@@ -22,10 +21,10 @@ void CreditsState::initTypewriter() {
 
     // Lấy toàn bộ nội dung cần hiển thị vào mảng
     mFullTextLines.clear();
-    mFullTextLines.push_back(res->getText("credits_title"));
-    mFullTextLines.push_back(res->getText("credits_student_1"));
-    mFullTextLines.push_back(res->getText("credits_student_2"));
-    mFullTextLines.push_back(res->getText("credits_instructor"));
+    mFullTextLines.emplace_back(res->getText(TXT_CREDITS_TITLE));
+    mFullTextLines.emplace_back(res->getText(TXT_CREDITS_STUDENT_1));
+    mFullTextLines.emplace_back(res->getText(TXT_CREDITS_STUDENT_2));
+    mFullTextLines.emplace_back(res->getText(TXT_CREDITS_INSTRUCTOR));
 
     // Khởi tạo mảng hiển thị rỗng
     mCurrentTextLines.clear();
@@ -86,26 +85,16 @@ void CreditsState::updateTypewriter() {
     }
 }
 
-// ... (initRain, updateRain giữ nguyên) ...
 void CreditsState::initRain() {
-    int numDrops = 100;
-    for (int i = 0; i < numDrops; ++i) {
-        RainDrop d;
-        d.x = (float)(rand() % SCREEN_WIDTH); d.y = (float)(rand() % SCREEN_HEIGHT);
-        d.speed = 2.0f + (rand() % 50) / 10.0f; d.length = 10 + rand() % 30;
-        d.width = 2 + rand() % 3; d.alpha = 50 + rand() % 150;
-        if (rand() % 2 == 0) d.color = { 0, 255, 255, 255 }; else d.color = { 0, 255, 100, 255 };
-        mRain.push_back(d);
-    }
-}
-
-void CreditsState::updateRain() {
-    for (auto& d : mRain) {
-        d.y += d.speed;
-        if (d.y > SCREEN_HEIGHT) {
-            d.y = -(float)d.length; d.x = (float)(rand() % SCREEN_WIDTH);
-        }
-    }
+    ParticleConfig config;
+    config.area = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+    config.fallDown = true;
+    config.minSpeed = 2.0f; config.speedRange = 5.0f;
+    config.minWidth = 2; config.widthRange = 3;
+    config.minHeight = 10; config.heightRange = 30;
+    config.minAlpha = 50; config.alphaRange = 150;
+    config.colors = { { 0, 255, 255, 255 }, { 0, 255, 100, 255 } };
+    mRain.init(config, 100, mGame->getEffectsRandom().nextU64());
 }
 
 void CreditsState::handleEvents(SDL_Event& e) {
@@ -123,7 +112,7 @@ void CreditsState::handleEvents(SDL_Event& e) {
 }
 
 void CreditsState::update() {
-    updateRain();
+    mRain.update();
     updateTypewriter(); // <--- CẬP NHẬT HIỆU ỨNG
 }
 
@@ -136,7 +125,7 @@ void CreditsState::draw(SDL_Renderer* renderer) {
     SDL_RenderClear(renderer);
 
     // 1. Vẽ mưa
-    drawRain(renderer);
+    mRain.draw(renderer);
 
     // 2. Vẽ khung
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
@@ -177,13 +166,3 @@ void CreditsState::draw(SDL_Renderer* renderer) {
     // 4. Vẽ nút Back
     mUI.draw(renderer);
 }
-
-void CreditsState::drawRain(SDL_Renderer* renderer) {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    for (const auto& d : mRain) {
-        SDL_SetRenderDrawColor(renderer, d.color.r, d.color.g, d.color.b, d.alpha);
-        SDL_Rect r = { (int)d.x, (int)d.y, d.width, d.length };
-        SDL_RenderFillRect(renderer, &r);
-    }
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-}
\ No newline at end of file
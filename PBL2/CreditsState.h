@@ -2,18 +2,10 @@
 #include "GameState.h"
 #include "UIManager.h"
 #include "Constants.h"
+#include "ParticleSystem.h"
 #include <vector>
 #include <string>
 
-struct RainDrop {
-    float x, y;
-    float speed;
-    int length;
-    int width;
-    int alpha;
-    SDL_Color color;
-};
-
 class CreditsState : public GameState {
 public:
     CreditsState(Game* game);
@@ -22,14 +14,14 @@ public:
     virtual void handleEvents(SDL_Event& e) override;
     virtual void update() override;
     virtual void draw(SDL_Renderer* renderer) override;
+    virtual const char* getName() const override { return "CreditsState"; }
+    virtual UIManager* getUI() override { return &mUI; }
 
 private:
     void initButtons();
 
     // === HIỆU ỨNG MƯA ===
     void initRain();
-    void updateRain();
-    void drawRain(SDL_Renderer* renderer);
 
     // === HIỆU ỨNG ĐÁNH MÁY (MỚI) ===
     void initTypewriter(); // Chuẩn bị nội dung
@@ -39,7 +31,7 @@ private:
     int getUTF8CharLength(unsigned char c);
 
     UIManager mUI;
-    std::vector<RainDrop> mRain;
+    ParticleSystem mRain;
 
     // Biến cho hiệu ứng đánh máy
     std::vector<std::string> mFullTextLines;    // Nội dung đầy đủ của từng dòng
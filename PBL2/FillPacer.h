@@ -0,0 +1,85 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+/**
+ * @class FillPacer
+ * @brief Chia việc phát lại hoạt ảnh tô theo thời gian thay vì số ô cố định mỗi khung hình.
+ *
+ * Lưới đã được tô xong ngay khi bắt đầu nước đi; hoạt ảnh chỉ chép dần các ô đã ghi sang lưới hiển thị.
+ * Mỗi lần phát lại được kéo dài đều trong targetMs: ở mỗi khung hình, số ô cần hiện tới lúc đó bằng
+ * tổng số ô nhân với tỉ lệ thời gian đã trôi qua. Số ô mỗi phần được suy ra từ thời gian mỗi ô
+ * đo được (trung bình trượt, giữ lại giữa các lần phát), và phần việc của một khung hình không vượt
+ * quá budgetMs, nên lần phát rất lớn chỉ kéo dài thêm chứ không làm tụt khung hình.
+ */
+class FillPacer {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    FillPacer(double targetMs = 0.0, double budgetMs = 0.0)
+        : mTargetMs(targetMs), mBudgetMs(budgetMs), mTotal(0), mDone(0), mFrameQuota(0), mMsPerCell(0.0) {}
+
+    void configure(double targetMs, double budgetMs) {
+        mTargetMs = targetMs;
+        mBudgetMs = budgetMs;
+    }
+
+    /**
+     * @brief Bắt đầu phát lại totalCells ô, kết thúc sau targetMs tính từ bây giờ.
+     */
+    void begin(int totalCells) {
+        mTotal = std::max(0, totalCells);
+        mDone = 0;
+        mStart = Clock::now();
+    }
+
+    /**
+     * @brief Tính số ô cần đạt trước khi hết khung hình này và hạn thời gian của khung hình.
+     */
+    void beginFrame() {
+        Clock::time_point now = Clock::now();
+        double elapsedMs = std::chrono::duration<double, std::milli>(now - mStart).count();
+        double progress = (mTargetMs > 0.0) ? std::min(1.0, elapsedMs / mTargetMs) : 1.0;
+        mFrameQuota = (int)std::ceil(mTotal * progress);
+        mFrameDeadline = now + std::chrono::microseconds((long long)(mBudgetMs * 1000.0));
+    }
+
+    /**
+     * @brief Số ô nên chép tiếp trong khung hình này, 0 nếu đã đủ chỉ tiêu hoặc hết ngân sách.
+     */
+    int nextChunk() const {
+        if (mDone >= mFrameQuota) return 0;
+        Clock::time_point now = Clock::now();
+        if (mBudgetMs > 0.0 && now >= mFrameDeadline) return 0;
+
+        double cells = mFrameQuota - mDone;
+        if (mBudgetMs > 0.0 && mMsPerCell > 0.0) {
+            double remainingMs = std::chrono::duration<double, std::milli>(mFrameDeadline - now).count();
+            cells = std::min(cells, remainingMs / mMsPerCell);
+        }
+        return std::max(1, (int)cells);
+    }
+
+    /**
+     * @brief Ghi nhận một phần vừa chép: cells ô trong ms mili giây.
+     */
+    void record(int cells, double ms) {
+        mDone += cells;
+        if (cells <= 0) return;
+        const double SMOOTHING = 0.3;
+        double msPerCell = ms / cells;
+        mMsPerCell = (mMsPerCell > 0.0) ? mMsPerCell + SMOOTHING * (msPerCell - mMsPerCell) : msPerCell;
+    }
+
+private:
+    double mTargetMs;
+    double mBudgetMs;
+    int mTotal;
+    int mDone;
+    int mFrameQuota;
+    double mMsPerCell; ///< Thời gian trung bình chép một ô (đo được), 0 khi chưa đo.
+    Clock::time_point mStart;
+    Clock::time_point mFrameDeadline;
+};
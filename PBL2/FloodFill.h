@@ -0,0 +1,589 @@
+﻿#pragma once
+
+#include "Constants.h"
+#include "CountingAllocator.h"
+#include "DSU.h"
+#include "Topology.h"
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <vector>
+
+/**
+ * @file FloodFill.h
+ * @brief Thư viện tô màu loang dùng chung cho Grid và AISolver.
+ *
+ * Mọi kernel đi theo danh sách kề dựng sẵn của Topology (ô vuông 4/8 hướng, hình xuyến, lục giác,
+ * bàn cờ có lỗ), nên vòng lặp trong chỉ duyệt một mảng phẳng, không kiểm tra biên hay rẽ nhánh theo hướng.
+ * Riêng bàn cờ ô vuông, các kernel mà danh sách kề chậm hơn vòng lặp trực tiếp (vùng (0,0), DFS, Scanline,
+ * Union-Find) vẫn dùng bảng hướng Neighbors<Dir> cố định lúc biên dịch.
+ * Kernel được template theo kiểu ô. Lưới có dạng cells[x][y] như trong Grid, cùng kích thước với topology.
+ */
+namespace FloodFill {
+
+template <typename Cell>
+using Board = std::vector<std::vector<Cell>>;
+
+typedef std::pair<int, int> CellPos;
+
+/**
+ * @brief So sánh hai ô; mặc định dùng operator==, SDL_Color dùng areColorsEqual().
+ */
+template <typename Cell>
+struct CellTraits {
+    static bool equal(const Cell& a, const Cell& b) { return a == b; }
+};
+
+template <>
+struct CellTraits<SDL_Color> {
+    static bool equal(const SDL_Color& a, const SDL_Color& b) { return areColorsEqual(a, b); }
+};
+
+/**
+ * @brief Bảng hướng của bàn cờ ô vuông. 4 phần tử đầu là 4 hướng, 4 phần tử sau là 4 đường chéo.
+ */
+template <FillDirection Dir>
+struct Neighbors {
+    static constexpr int count = (Dir == DIR_FOUR) ? 4 : 8;
+    static constexpr int dx[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+    static constexpr int dy[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+
+    /// Nửa "tiến" của bảng (phải, dưới và hai chéo dưới), đủ để nối mỗi cặp ô đúng một lần.
+    static constexpr int forwardCount = (Dir == DIR_FOUR) ? 2 : 4;
+    static constexpr int forwardDx[4] = { 1, 0, 1, -1 };
+    static constexpr int forwardDy[4] = { 0, 1, 1, 1 };
+};
+
+template <FillDirection Dir> constexpr int Neighbors<Dir>::dx[8];
+template <FillDirection Dir> constexpr int Neighbors<Dir>::dy[8];
+template <FillDirection Dir> constexpr int Neighbors<Dir>::forwardDx[4];
+template <FillDirection Dir> constexpr int Neighbors<Dir>::forwardDy[4];
+
+/**
+ * @brief Bộ đếm hiệu năng của các kernel tô màu.
+ */
+struct FillStats {
+    long long cellsVisited = 0;  ///< Số ô được lấy ra/quét khi tô màu.
+    long long redundantPops = 0; ///< Số lần lấy ra một ô không cần tô (đã tô hoặc khác màu).
+    long long peakContainer = 0; ///< Kích thước lớn nhất của hàng đợi/ngăn xếp/mảng DSU.
+    long long allocations = 0;   ///< Số lần cấp phát bộ nhớ của các container tô màu.
+
+    void notePeak(size_t size) { if ((long long)size > peakContainer) peakContainer = (long long)size; }
+};
+
+/**
+ * @struct Scratch
+ * @brief Bộ nhớ tạm dùng lại giữa các lần gọi kernel (vùng (0,0), nước tham lam, tìm kiếm gợi ý).
+ *
+ * Thay cho mảng visited cấp phát mới mỗi lần gọi: mỗi lần duyệt lấy một "thế hệ" mới và một ô được
+ * coi là đã đánh dấu khi stamp của nó bằng thế hệ đó, nên không phải xóa mảng giữa các lần gọi.
+ * Sau lần gọi đầu tiên với lưới lớn nhất, các kernel dùng Scratch không cấp phát thêm.
+ * Mỗi luồng dùng một Scratch riêng.
+ */
+struct Scratch {
+    std::vector<unsigned int> stamps; ///< Một stamp mỗi ô, chỉ số x * dim + y.
+    std::vector<CellPos> work;        ///< Hàng đợi BFS; sau khi duyệt chứa đúng các ô của vùng.
+    unsigned int generation = 0;      ///< Thế hệ lớn nhất đã cấp.
+    MemoryCharge charge{ MEM_FILL_CONTAINERS };
+
+    /**
+     * @brief Chuẩn bị cho lưới có cellCount ô và dành count thế hệ liên tiếp.
+     * @return Thế hệ đầu tiên trong count thế hệ vừa dành.
+     */
+    unsigned int beginGenerations(size_t cellCount, unsigned int count) {
+        if (stamps.size() < cellCount) stamps.resize(cellCount, 0);
+        if (generation > std::numeric_limits<unsigned int>::max() - count) {
+            // Bộ đếm sắp tràn: xóa mảng một lần rồi đếm lại từ đầu
+            std::fill(stamps.begin(), stamps.end(), 0u);
+            generation = 0;
+        }
+        charge.set(stamps.capacity() * sizeof(unsigned int) + work.capacity() * sizeof(CellPos));
+        unsigned int first = generation + 1;
+        generation += count;
+        return first;
+    }
+};
+
+/**
+ * @brief regionFromOrigin() trên bàn cờ ô vuông: tính lân cận từ bảng hướng thay vì đọc danh sách kề.
+ */
+template <FillDirection Dir, typename Cell>
+void regionFromOriginSquare(const Board<Cell>& cells, std::vector<CellPos>& queue, unsigned int* visited, unsigned int gen) {
+    typedef Neighbors<Dir> N;
+    const int dim = (int)cells.size();
+    const Cell target = cells[0][0];
+    for (size_t head = 0; head < queue.size(); ++head) {
+        int x = queue[head].first, y = queue[head].second;
+        for (int i = 0; i < N::count; ++i) {
+            int nx = x + N::dx[i], ny = y + N::dy[i];
+            if (nx >= 0 && nx < dim && ny >= 0 && ny < dim &&
+                visited[nx * dim + ny] != gen && CellTraits<Cell>::equal(cells[nx][ny], target)) {
+                visited[nx * dim + ny] = gen;
+                queue.push_back({ nx, ny });
+            }
+        }
+    }
+}
+
+/**
+ * @brief BFS tìm vùng liên thông cùng màu với ô (0,0).
+ *
+ * Các ô của vùng nằm trong scratch.work và có stamp bằng thế hệ được trả về qua *generation (nếu khác null).
+ * @return Số ô trong vùng.
+ */
+template <typename Cell>
+int regionFromOrigin(const Board<Cell>& cells, const Topology& topo, Scratch& scratch, unsigned int* generation = nullptr) {
+    int dim = (int)cells.size();
+    std::vector<CellPos>& queue = scratch.work;
+    queue.clear();
+    if (dim == 0) return 0;
+
+    const unsigned int gen = scratch.beginGenerations((size_t)dim * dim, 1);
+    unsigned int* visited = scratch.stamps.data();
+    if (generation) *generation = gen;
+
+    const Cell target = cells[0][0];
+    queue.push_back({ 0, 0 });
+    visited[0] = gen;
+    if (topo.getShape() == SHAPE_SQUARE) {
+        if (topo.getFillDirection() == DIR_EIGHT) regionFromOriginSquare<DIR_EIGHT>(cells, queue, visited, gen);
+        else regionFromOriginSquare<DIR_FOUR>(cells, queue, visited, gen);
+        return (int)queue.size();
+    }
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const uint32_t index = (uint32_t)(queue[head].first * dim + queue[head].second);
+        for (const Topology::Neighbor* n = topo.neighborsBegin(index), *end = topo.neighborsEnd(index); n != end; ++n) {
+            const uint32_t next = (uint32_t)(n->x * dim + n->y);
+            if (visited[next] != gen && CellTraits<Cell>::equal(cells[n->x][n->y], target)) {
+                visited[next] = gen;
+                queue.push_back({ n->x, n->y });
+            }
+        }
+    }
+    return (int)queue.size();
+}
+
+/**
+ * @brief Như trên nhưng xuất vùng ra mảng hai chiều.
+ * @param visited Được đưa về kích thước dim x dim (giữ lại bộ nhớ cũ nếu cùng kích thước), đánh dấu các ô thuộc vùng.
+ */
+template <typename Cell>
+int regionFromOrigin(const Board<Cell>& cells, const Topology& topo, std::vector<std::vector<bool>>& visited, Scratch& scratch) {
+    int size = regionFromOrigin(cells, topo, scratch);
+    size_t dim = cells.size();
+    visited.resize(dim);
+    for (auto& column : visited) column.assign(dim, false);
+    for (const CellPos& p : scratch.work) visited[p.first][p.second] = true;
+    return size;
+}
+
+/**
+ * @brief Chọn màu làm vùng (0,0) lớn nhất sau một nước đi (chiến lược tham lam).
+ *
+ * Vùng hiện tại chỉ được tìm một lần; với mỗi màu ứng viên, BFS mở rộng từ vùng đó
+ * qua các ô cùng màu ứng viên, không cần sao chép lưới.
+ * @return Chỉ số trong palette của màu tốt nhất, hoặc -1 nếu không có màu nào khác màu hiện tại.
+ */
+template <typename Cell>
+int bestMove(const Board<Cell>& cells, const Topology& topo, const Cell* palette, int numColors, Scratch& scratch) {
+    int dim = (int)cells.size();
+    if (dim == 0) return -1;
+
+    // Thế hệ REGION cho vùng hiện tại, REGION + 1 + i cho các ô đã gộp khi thử màu i
+    const Cell start = cells[0][0];
+    const unsigned int REGION = scratch.beginGenerations((size_t)dim * dim, (unsigned int)numColors + 1);
+    unsigned int* mark = scratch.stamps.data();
+
+    std::vector<CellPos>& work = scratch.work;
+    work.clear();
+    work.push_back({ 0, 0 });
+    mark[0] = REGION;
+    for (size_t head = 0; head < work.size(); ++head) {
+        const uint32_t index = (uint32_t)(work[head].first * dim + work[head].second);
+        for (const Topology::Neighbor* n = topo.neighborsBegin(index), *end = topo.neighborsEnd(index); n != end; ++n) {
+            const uint32_t next = (uint32_t)(n->x * dim + n->y);
+            if (mark[next] != REGION && CellTraits<Cell>::equal(cells[n->x][n->y], start)) {
+                mark[next] = REGION;
+                work.push_back({ n->x, n->y });
+            }
+        }
+    }
+    const size_t regionSize = work.size();
+
+    int bestIndex = -1;
+    int bestSize = -1;
+    for (int c = 0; c < numColors; ++c) {
+        const Cell& color = palette[c];
+        if (CellTraits<Cell>::equal(color, start)) continue;
+
+        const unsigned int stamp = REGION + 1 + (unsigned int)c;
+        work.resize(regionSize);
+        for (size_t head = 0; head < work.size(); ++head) {
+            const uint32_t index = (uint32_t)(work[head].first * dim + work[head].second);
+            for (const Topology::Neighbor* n = topo.neighborsBegin(index), *end = topo.neighborsEnd(index); n != end; ++n) {
+                unsigned int& m = mark[n->x * dim + n->y];
+                if (m != REGION && m != stamp && CellTraits<Cell>::equal(cells[n->x][n->y], color)) {
+                    m = stamp;
+                    work.push_back({ n->x, n->y });
+                }
+            }
+        }
+
+        if ((int)work.size() > bestSize) {
+            bestSize = (int)work.size();
+            bestIndex = c;
+        }
+    }
+    return bestIndex;
+}
+
+/**
+ * @class Filler
+ * @brief Trạng thái một lần tô màu từng bước (BFS, DFS, Scanline) và tô một lần (Union-Find).
+ *
+ * Việc ghi ô do caller quyết định qua writer(x, y), nên Grid vẫn là nơi duy nhất cập nhật
+ * bảng đếm màu. Container được giữ lại giữa các lần tô để không phải cấp phát lại.
+ * Mọi lần gọi trong cùng một lần tô phải dùng cùng một topology.
+ */
+template <typename Cell>
+class Filler {
+public:
+    Filler()
+        : mAlgo(ALGO_BFS), mActive(false),
+        mQueue(CountingAllocator<CellPos>(&mStats.allocations)),
+        mStack(CountingAllocator<CellPos>(&mStats.allocations))
+    {
+        mTarget = Cell();
+    }
+
+    Filler(const Filler&) = delete;
+    Filler& operator=(const Filler&) = delete;
+
+    /**
+     * @brief Bắt đầu một lần tô từng bước từ ô (x, y), thay các ô có màu target.
+     */
+    void begin(AlgorithmType algo, const Cell& target, int x, int y) {
+        mAlgo = algo;
+        mTarget = target;
+        mQueue.clear();
+        mStack.clear();
+        if (algo == ALGO_BFS) mQueue.push_back({ x, y });
+        else mStack.push_back({ x, y });
+        mActive = true;
+        mStats.notePeak(1);
+    }
+
+    /**
+     * @brief Chạy tối đa maxSteps bước (mỗi bước là một ô với BFS/DFS, một đoạn ngang với Scanline).
+     * @return Số ô đã được ghi qua writer.
+     */
+    template <typename Writer>
+    int step(const Board<Cell>& cells, const Topology& topo, int maxSteps, Writer write) {
+        if (!mActive) return 0;
+        int filled = 0;
+        switch (mAlgo) {
+        case ALGO_BFS: filled = stepQueue(cells, topo, maxSteps, write); break;
+        case ALGO_DFS:
+            if (topo.getShape() != SHAPE_SQUARE) filled = stepStack(cells, topo, maxSteps, write);
+            else if (topo.getFillDirection() == DIR_EIGHT) filled = stepStackSquare<DIR_EIGHT>(cells, maxSteps, write);
+            else filled = stepStackSquare<DIR_FOUR>(cells, maxSteps, write);
+            break;
+        case ALGO_SCANLINE: filled = stepScanline(cells, topo, maxSteps, write); break;
+        default: mActive = false; break;
+        }
+        return filled;
+    }
+
+    /**
+     * @brief Chạy lần tô đã begin() tới hết. writer nhận các ô theo đúng thứ tự của thuật toán.
+     * @return Số ô đã được ghi qua writer.
+     */
+    template <typename Writer>
+    int fillAll(const Board<Cell>& cells, const Topology& topo, Writer write) {
+        return step(cells, topo, std::numeric_limits<int>::max(), write);
+    }
+
+    /**
+     * @brief Tô toàn bộ vùng chứa (0,0) trong một lần bằng Union-Find.
+     *
+     * Mỗi ô chỉ nối với các lân cận có chỉ số lớn hơn (đuôi danh sách kề), nên mỗi cạnh được xét một lần.
+     * Các ô được ghi theo thứ tự hàng như trên màn hình.
+     * @return Số ô đã được ghi qua writer.
+     */
+    template <typename Writer>
+    int fillUnionFind(const Board<Cell>& cells, const Topology& topo, Writer write) {
+        if (topo.getShape() == SHAPE_SQUARE) {
+            if (topo.getFillDirection() == DIR_EIGHT) return fillUnionFindSquare<DIR_EIGHT>(cells, write);
+            return fillUnionFindSquare<DIR_FOUR>(cells, write);
+        }
+        int dim = (int)cells.size();
+        if (dim == 0) return 0;
+        const Cell target = cells[0][0];
+
+        DSU dsu(dim * dim);
+        mStats.allocations++;
+        mStats.notePeak((size_t)dim * dim);
+        mStats.cellsVisited += 2LL * dim * dim;
+        for (int y = 0; y < dim; ++y) {
+            for (int x = 0; x < dim; ++x) {
+                if (!CellTraits<Cell>::equal(cells[x][y], target)) continue;
+                const uint32_t index = (uint32_t)(x * dim + y);
+                for (const Topology::Neighbor* n = topo.forwardBegin(index), *end = topo.neighborsEnd(index); n != end; ++n) {
+                    if (CellTraits<Cell>::equal(cells[n->x][n->y], target)) dsu.unite(y * dim + x, n->y * dim + n->x);
+                }
+            }
+        }
+
+        // Ô bị khoét không có cạnh nào nên không bao giờ cùng gốc với (0,0)
+        return writeRegion(cells, target, dsu, write);
+    }
+
+    bool isActive() const { return mActive; }
+
+    void cancel() { mActive = false; mQueue.clear(); mStack.clear(); }
+
+    const FillStats& getStats() const { return mStats; }
+    void resetStats() { mStats = FillStats(); }
+
+private:
+    typedef std::deque<CellPos, CountingAllocator<CellPos>> Queue;
+    typedef std::vector<CellPos, CountingAllocator<CellPos>> Stack;
+
+    bool accepts(const Board<Cell>& cells, int x, int y) const {
+        return CellTraits<Cell>::equal(cells[x][y], mTarget);
+    }
+
+    template <FillDirection Dir, typename Writer>
+    int fillUnionFindSquare(const Board<Cell>& cells, Writer& write) {
+        typedef Neighbors<Dir> N;
+        int dim = (int)cells.size();
+        if (dim == 0) return 0;
+        const Cell target = cells[0][0];
+
+        DSU dsu(dim * dim);
+        mStats.allocations++;
+        mStats.notePeak((size_t)dim * dim);
+        mStats.cellsVisited += 2LL * dim * dim;
+        for (int y = 0; y < dim; ++y) {
+            for (int x = 0; x < dim; ++x) {
+                if (!CellTraits<Cell>::equal(cells[x][y], target)) continue;
+                for (int i = 0; i < N::forwardCount; ++i) {
+                    int nx = x + N::forwardDx[i], ny = y + N::forwardDy[i];
+                    if (nx >= 0 && nx < dim && ny < dim && CellTraits<Cell>::equal(cells[nx][ny], target)) {
+                        dsu.unite(y * dim + x, ny * dim + nx);
+                    }
+                }
+            }
+        }
+        return writeRegion(cells, target, dsu, write);
+    }
+
+    /**
+     * Ghi theo thứ tự hàng các ô màu target cùng gốc với (0,0).
+     */
+    template <typename Writer>
+    int writeRegion(const Board<Cell>& cells, const Cell target, DSU& dsu, Writer& write) {
+        const int dim = (int)cells.size();
+        int startRoot = dsu.find(0);
+        int filled = 0;
+        for (int y = 0; y < dim; ++y) {
+            for (int x = 0; x < dim; ++x) {
+                if (CellTraits<Cell>::equal(cells[x][y], target) && dsu.find(y * dim + x) == startRoot) {
+                    write(x, y);
+                    filled++;
+                }
+            }
+        }
+        mActive = false;
+        return filled;
+    }
+
+    template <typename Writer>
+    int stepQueue(const Board<Cell>& cells, const Topology& topo, int maxSteps, Writer& write) {
+        const int dim = topo.getDim();
+        int filled = 0;
+        while (!mQueue.empty() && filled < maxSteps) {
+            CellPos curr = mQueue.front(); mQueue.pop_front();
+            mStats.cellsVisited++;
+            int x = curr.first, y = curr.second;
+            if (!accepts(cells, x, y)) { mStats.redundantPops++; continue; }
+            write(x, y);
+            filled++;
+            const uint32_t index = (uint32_t)(x * dim + y);
+            for (const Topology::Neighbor* n = topo.neighborsBegin(index), *end = topo.neighborsEnd(index); n != end; ++n) {
+                if (accepts(cells, n->x, n->y)) mQueue.push_back({ n->x, n->y });
+            }
+            mStats.notePeak(mQueue.size());
+        }
+        if (mQueue.empty()) mActive = false;
+        return filled;
+    }
+
+    template <typename Writer>
+    int stepStack(const Board<Cell>& cells, const Topology& topo, int maxSteps, Writer& write) {
+        const int dim = topo.getDim();
+        int filled = 0;
+        while (!mStack.empty() && filled < maxSteps) {
+            CellPos curr = mStack.back(); mStack.pop_back();
+            mStats.cellsVisited++;
+            int x = curr.first, y = curr.second;
+            if (!accepts(cells, x, y)) { mStats.redundantPops++; continue; }
+            write(x, y);
+            filled++;
+            const uint32_t index = (uint32_t)(x * dim + y);
+            for (const Topology::Neighbor* n = topo.neighborsBegin(index), *end = topo.neighborsEnd(index); n != end; ++n) {
+                if (accepts(cells, n->x, n->y)) mStack.push_back({ n->x, n->y });
+            }
+            mStats.notePeak(mStack.size());
+        }
+        if (mStack.empty()) mActive = false;
+        return filled;
+    }
+
+    template <FillDirection Dir, typename Writer>
+    int stepStackSquare(const Board<Cell>& cells, int maxSteps, Writer& write) {
+        typedef Neighbors<Dir> N;
+        const int dim = (int)cells.size();
+        const Cell target = mTarget; // Bản sao cục bộ: writer ghi vào lưới nên trình biên dịch không giữ được mTarget trong thanh ghi
+        auto open = [&](int column, int row) { return CellTraits<Cell>::equal(cells[column][row], target); };
+        int filled = 0;
+        while (!mStack.empty() && filled < maxSteps) {
+            CellPos curr = mStack.back(); mStack.pop_back();
+            mStats.cellsVisited++;
+            int x = curr.first, y = curr.second;
+            if (!open(x, y)) { mStats.redundantPops++; continue; }
+            write(x, y);
+            filled++;
+            for (int i = 0; i < N::count; ++i) {
+                int nx = x + N::dx[i], ny = y + N::dy[i];
+                if (nx >= 0 && nx < dim && ny >= 0 && ny < dim && open(nx, ny)) mStack.push_back({ nx, ny });
+            }
+            mStats.notePeak(mStack.size());
+        }
+        if (mStack.empty()) mActive = false;
+        return filled;
+    }
+
+    /**
+     * Mỗi bước tô một đoạn ngang (dừng ở lỗ, quay vòng trên hình xuyến) rồi đẩy ô đầu của mỗi đoạn còn màu target
+     * ở hàng trên và dưới. Khoảng quét ở hàng kề lấy từ getRowReach(): nới một ô mỗi bên với 8 hướng,
+     * lệch nửa ô theo hàng chẵn/lẻ với lục giác. Scanline vốn đi theo hàng nên quét thẳng các cột thay vì danh sách kề.
+     */
+    template <typename Writer>
+    int stepScanline(const Board<Cell>& cells, const Topology& topo, int maxSteps, Writer& write) {
+        if (topo.getShape() == SHAPE_SQUARE) {
+            if (topo.getFillDirection() == DIR_EIGHT) return stepScanlineSquare<DIR_EIGHT>(cells, maxSteps, write);
+            return stepScanlineSquare<DIR_FOUR>(cells, maxSteps, write);
+        }
+        if (topo.hasHoles()) return stepScanlineRows<true, false>(cells, topo, maxSteps, write);
+        if (topo.wraps()) return stepScanlineRows<false, true>(cells, topo, maxSteps, write);
+        return stepScanlineRows<false, false>(cells, topo, maxSteps, write);
+    }
+
+    template <bool Holes, bool Wrap, typename Writer>
+    int stepScanlineRows(const Board<Cell>& cells, const Topology& topo, int maxSteps, Writer& write) {
+        const int dim = topo.getDim();
+        auto open = [&](int column, int row) {
+            return (!Holes || topo.isActiveIndex(column * dim + row)) && accepts(cells, column, row);
+        };
+        int filled = 0;
+        int spans = 0;
+        while (!mStack.empty() && spans < maxSteps) {
+            CellPos curr = mStack.back(); mStack.pop_back();
+            int x = curr.first, y = curr.second;
+            if (!accepts(cells, x, y)) { mStats.redundantPops++; continue; }
+
+            int west = x, length;
+            if (!Wrap) {
+                int east = x;
+                while (west > 0 && open(west - 1, y)) west--;
+                while (east < dim - 1 && open(east + 1, y)) east++;
+                length = east - west + 1;
+                for (int i = west; i <= east; ++i) write(i, y);
+            }
+            else {
+                // Hàng quay vòng: đoạn dài nhất dim ô để không đi lặp
+                length = 1;
+                for (int w = (x + dim - 1) % dim; length < dim && open(w, y); w = (w + dim - 1) % dim) { west = w; length++; }
+                for (int e = (x + 1) % dim; length < dim && open(e, y); e = (e + 1) % dim) length++;
+                for (int i = 0, column = west; i < length; ++i, column = (column + 1) % dim) write(column, y);
+            }
+            filled += length;
+            mStats.cellsVisited += length;
+
+            int lo, hi;
+            topo.getRowReach(y, lo, hi);
+            int scanFrom = west + lo;
+            int scanCount = length + hi - lo;
+            if (Wrap) {
+                scanFrom = (scanFrom + dim) % dim;
+                scanCount = std::min(scanCount, dim);
+            }
+            else {
+                if (scanFrom < 0) { scanCount += scanFrom; scanFrom = 0; }
+                scanCount = std::min(scanCount, dim - scanFrom);
+            }
+            const int rows[2] = { topo.rowAbove(y), topo.rowBelow(y) };
+            for (int ny : rows) {
+                if (ny < 0) continue;
+                bool previous = false;
+                for (int i = 0, column = scanFrom; i < scanCount; ++i) {
+                    bool current = open(column, ny);
+                    if (current && !previous) mStack.push_back({ column, ny });
+                    previous = current;
+                    if (++column == dim && Wrap) column = 0; // Chỉ xảy ra trên hình xuyến
+                }
+            }
+            mStats.notePeak(mStack.size());
+            spans++;
+        }
+        if (mStack.empty()) mActive = false;
+        return filled;
+    }
+
+    /**
+     * Scanline trên bàn cờ ô vuông: với 8 hướng, khoảng quét ở hàng kề được nới thêm một ô mỗi bên để bắt các ô chéo.
+     */
+    template <FillDirection Dir, typename Writer>
+    int stepScanlineSquare(const Board<Cell>& cells, int maxSteps, Writer& write) {
+        const int reach = (Dir == DIR_EIGHT) ? 1 : 0;
+        const int dim = (int)cells.size();
+        const Cell target = mTarget; // Như stepStackSquare
+        auto open = [&](int column, int row) { return CellTraits<Cell>::equal(cells[column][row], target); };
+        int filled = 0;
+        int spans = 0;
+        while (!mStack.empty() && spans < maxSteps) {
+            CellPos curr = mStack.back(); mStack.pop_back();
+            int x = curr.first, y = curr.second;
+            if (!open(x, y)) { mStats.redundantPops++; continue; }
+
+            int west = x; while (west > 0 && open(west - 1, y)) west--;
+            int east = x; while (east < dim - 1 && open(east + 1, y)) east++;
+            for (int i = west; i <= east; ++i) write(i, y);
+            filled += east - west + 1;
+            mStats.cellsVisited += east - west + 1;
+
+            int scanFrom = std::max(0, west - reach);
+            int scanTo = std::min(dim - 1, east + reach);
+            for (int ny = y - 1; ny <= y + 1; ny += 2) {
+                if (ny < 0 || ny >= dim) continue;
+                for (int i = scanFrom; i <= scanTo; ++i) {
+                    if (open(i, ny) && (i == scanFrom || !open(i - 1, ny))) mStack.push_back({ i, ny });
+                }
+            }
+            mStats.notePeak(mStack.size());
+            spans++;
+        }
+        if (mStack.empty()) mActive = false;
+        return filled;
+    }
+
+    AlgorithmType mAlgo;
+    bool mActive;
+    Cell mTarget;
+    FillStats mStats; // Khai báo trước các container vì allocator của chúng trỏ vào mStats.allocations
+    Queue mQueue;     // Hàng đợi BFS
+    Stack mStack;     // Ngăn xếp DFS và Scanline
+};
+
+} // namespace FloodFill
@@ -4,26 +4,55 @@
 #include "PlayingState.h" 
 #include "ResourceManager.h"
 #include "Constants.h"
+#include "MemoryStats.h"
+#include "Trace.h"
 #include <iostream>
 #include <fstream>
 #include <cstdio> 
+#include <iomanip>
 #include <sstream>
+#include <chrono>
 #include <SDL_mixer.h>
 
+namespace {
+    // Số hiệu các luồng số ngẫu nhiên tách từ seed của phiên (xem Random::deriveSeed)
+    const uint64_t SEED_STREAM_LEVEL = 1;
+    const uint64_t SEED_STREAM_AI_MAP = 2;
+    const uint64_t SEED_STREAM_EFFECTS = 3;
+}
+
 Game::Game()
     : mIsRunning(true), mWindow(nullptr), mRenderer(nullptr),
     mSaveFileExists(false), mHighestLevel(1),
-    mCurrentAlgorithm(ALGO_BFS), mFillDirection(DIR_FOUR), mNumColors(6),
-    mGameDifficulty(DIFF_NORMAL)
+    mCurrentAlgorithm(ALGO_BFS), mFillDirection(DIR_FOUR), mBoardShape(SHAPE_SQUARE), mNumColors(6),
+    mGameDifficulty(DIFF_NORMAL),
+    mSeed(0), mHasExplicitSeed(false), mLevelRunCount(0), mAIRunCount(0), mStartupReported(false), mRenderResetCount(0), mShowMemoryOverlay(false)
 {
 }
 
+uint64_t Game::nextLevelSeed(int level) {
+    uint64_t levelSeed = Random::deriveSeed(Random::deriveSeed(mSeed, SEED_STREAM_LEVEL), (uint64_t)level);
+    return Random::deriveSeed(levelSeed, (uint64_t)mLevelRunCount++);
+}
+
+uint64_t Game::nextAIMapSeed() {
+    return Random::deriveSeed(Random::deriveSeed(mSeed, SEED_STREAM_AI_MAP), (uint64_t)mAIRunCount++);
+}
+
 Game::~Game() {
     close();
 }
 
 
 bool Game::init() {
+    mStartupBegin = mStartupMark = std::chrono::steady_clock::now();
+
+    if (!mHasExplicitSeed) {
+        mSeed = (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    }
+    mEffectsRandom.setSeed(Random::deriveSeed(mSeed, SEED_STREAM_EFFECTS));
+    std::cout << "Seed: " << mSeed << std::endl;
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0 || TTF_Init() == -1) {
         std::cerr << "SDL hoặc TTF không thể khởi tạo! SDL_Error: " << SDL_GetError() << ", TTF_Error: " << TTF_GetError() << std::endl;
         return false;
@@ -36,6 +65,7 @@ bool Game::init() {
     if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
         std::cerr << "SDL_mixer error: Mix_OpenAudio failed! Mix_Error: " << Mix_GetError() << "\n";
     }
+    markStartupPhase("sdl_init");
 
     mWindow = SDL_CreateWindow("Fill Color Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);
     if (!mWindow) {
@@ -43,19 +73,37 @@ bool Game::init() {
         return false;
     }
 
-    mRenderer = SDL_CreateRenderer(mWindow, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    // Driver dummy không có GPU; cũng bỏ vsync để đo đúng thời gian xử lý của khung hình
+    Uint32 rendererFlags = mHeadless ? SDL_RENDERER_SOFTWARE : (SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    mRenderer = SDL_CreateRenderer(mWindow, -1, rendererFlags);
     if (!mRenderer) {
         std::cerr << "Không thể tạo renderer! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
 
-    if (!mResourceManager.loadFonts("Baloo2-Bold.ttf")) {
-        return false;
+    markStartupPhase("window");
+
+    // Đọc cài đặt trước để luồng nền mở ngay font của ngôn ngữ đã chọn
+    loadSettings();
+    mResourceManager.beginAsyncLoad("background_music.mp3");
+
+    // Các việc nhỏ của luồng chính chạy song song với việc tải tài nguyên
+    checkForSaveFile();
+
+    if (mLevelPack.open(LEVEL_PACK_FILE)) {
+        std::cout << "Đã nạp level pack: " << LEVEL_PACK_FILE << std::endl;
     }
+    loadHighestLevel();
+    markStartupPhase("settings");
 
-    mResourceManager.loadGameSounds();
+    runLoadingScreen();
+    if (!mResourceManager.finishAsyncLoad()) {
+        std::cerr << "Không thể tải font!" << std::endl;
+        return false;
+    }
+    markStartupPhase("asset_wait");
 
-    if (mResourceManager.loadMusic("background_music.mp3")) {
+    if (mResourceManager.getBackgroundMusic()) {
         if (Mix_PlayMusic(mResourceManager.getBackgroundMusic(), -1) == -1) {
             std::cerr << "Mix_PlayMusic Error: " << Mix_GetError() << std::endl;
         }
@@ -64,24 +112,118 @@ bool Game::init() {
         std::cerr << "Warning: Could not load background_music.mp3" << std::endl;
     }
 
-    loadSettings();
-    mResourceManager.loadTranslations();
+    pushState(new MainMenuState(this));
+    markStartupPhase("main_menu");
 
-    checkForSaveFile();
-    loadHighestLevel();
+    return true;
+}
 
-    pushState(new MainMenuState(this));
+void Game::runLoadingScreen() {
+    const int barW = 400, barH = 16;
+    SDL_Rect frame = { (SCREEN_WIDTH - barW) / 2, (SCREEN_HEIGHT - barH) / 2, barW, barH };
+
+    while (!mResourceManager.isLoadFinished()) {
+        SDL_Event e;
+        while (SDL_PollEvent(&e)) {
+            if (e.type == SDL_QUIT) mIsRunning = false;
+        }
+
+        SDL_SetRenderDrawColor(mRenderer, BG_COLOR.r, BG_COLOR.g, BG_COLOR.b, 255);
+        SDL_RenderClear(mRenderer);
 
+        SDL_SetRenderDrawColor(mRenderer, UI_BG_COLOR.r, UI_BG_COLOR.g, UI_BG_COLOR.b, 255);
+        SDL_RenderFillRect(mRenderer, &frame);
+
+        SDL_Rect fill = frame;
+        fill.w = (int)(barW * mResourceManager.getLoadProgress());
+        SDL_SetRenderDrawColor(mRenderer, BUTTON_HIGHLIGHT.r, BUTTON_HIGHLIGHT.g, BUTTON_HIGHLIGHT.b, 255);
+        SDL_RenderFillRect(mRenderer, &fill);
+
+        SDL_RenderPresent(mRenderer);
+        SDL_Delay(10);
+    }
+}
+
+void Game::markStartupPhase(const char* name) {
+    auto now = std::chrono::steady_clock::now();
+    mStartupPhases.emplace_back(name, std::chrono::duration<double, std::milli>(now - mStartupMark).count());
+    mStartupMark = now;
+}
+
+void Game::reportStartup() {
+    mStartupReported = true;
+    markStartupPhase("first_frame");
+    double totalMs = std::chrono::duration<double, std::milli>(mStartupMark - mStartupBegin).count();
+    const AssetLoadTimings& assets = mResourceManager.getLoadTimings();
+
+    // Định dạng vào chuỗi riêng để std::fixed/setprecision không bám lại trên std::cout
+    std::ostringstream line;
+    line << "Thời gian khởi động (ms):" << std::fixed << std::setprecision(1);
+    for (const auto& phase : mStartupPhases) {
+        line << " " << phase.first << "=" << phase.second;
+    }
+    line << " | tải nền: fonts=" << assets.fontsMs << " sounds=" << assets.soundsMs << " music=" << assets.musicMs
+        << " | tổng=" << totalMs;
+    std::cout << line.str() << std::endl;
+
+    std::ofstream logFile(STARTUP_LOG_FILE, std::ios::app);
+    if (!logFile.is_open()) {
+        std::cerr << "Không thể ghi " << STARTUP_LOG_FILE << "!" << std::endl;
+        return;
+    }
+    logFile << "build=\"" << __DATE__ << " " << __TIME__ << "\"" << std::fixed << std::setprecision(1);
+    for (const auto& phase : mStartupPhases) {
+        logFile << " " << phase.first << "=" << phase.second;
+    }
+    logFile << " fonts=" << assets.fontsMs << " sounds=" << assets.soundsMs << " music=" << assets.musicMs
+        << " total=" << totalMs << "\n";
+}
+
+bool Game::enableHeadless(const std::string& scriptPath, const std::string& reportPath) {
+    mHeadless.reset(new HeadlessRunner());
+    if (!mHeadless->loadScript(scriptPath)) {
+        mHeadless.reset();
+        return false;
+    }
+    mFrameReportPath = reportPath;
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
     return true;
 }
 
 void Game::run() {
+    TRACE_THREAD_NAME("Main");
     while (mIsRunning) {
+        TRACE_SCOPE("Frame");
+        if (!mHeadless) {
+            handleEvents();
+            update();
+            draw();
+            if (!mStartupReported) reportStartup();
+
+            SDL_Delay(10);
+            continue;
+        }
+
+        // Chạy không màn hình: đưa lệnh kịch bản vào hàng đợi sự kiện, đo update/draw, không ngủ giữa các khung hình
+        mHeadless->beginFrame(*this);
+        auto frameStart = std::chrono::steady_clock::now();
         handleEvents();
         update();
+        auto updateEnd = std::chrono::steady_clock::now();
         draw();
+        auto drawEnd = std::chrono::steady_clock::now();
+        if (!mStartupReported) reportStartup();
+
+        GameState* top = getTopState();
+        mHeadless->recordFrame(top ? top->getName() : "(none)",
+            std::chrono::duration<double, std::milli>(updateEnd - frameStart).count(),
+            std::chrono::duration<double, std::milli>(drawEnd - updateEnd).count());
+        if (mHeadless->isFinished()) requestQuit();
+    }
 
-        SDL_Delay(10);
+    if (mHeadless) {
+        mHeadless->writeReport(mFrameReportPath);
     }
 }
 
@@ -121,13 +263,32 @@ float Game::getDifficultyModifier() const {
     }
 }
 
+int Game::getFormulaMaxMoves(int gridDim, int numColors) const {
+    float modifier = getDifficultyModifier();
+    return static_cast<int>((gridDim * gridDim * numColors) / (gridDim * modifier) + 5);
+}
+
+int Game::getMaxMovesForSolution(int solutionMoves) const {
+    // Phần trăm dư và số bước dư tối thiểu theo độ khó
+    int percent, minimum;
+    switch (mGameDifficulty) {
+    case DIFF_EASY:   percent = 40; minimum = 3; break;
+    case DIFF_HARD:   percent = 10; minimum = 1; break;
+    case DIFF_NORMAL:
+    default:          percent = 20; minimum = 2; break;
+    }
+    return solutionMoves + std::max(minimum, (solutionMoves * percent + 99) / 100);
+}
+
 void Game::saveSettings() {
+    if (mHeadless) return; // Chạy theo kịch bản không được ghi đè cài đặt và tiến độ của người chơi
     std::ofstream settingsFile("settings.ini");
     if (!settingsFile.is_open()) return;
     settingsFile << "Language=" << mResourceManager.getLanguage() << std::endl;
     settingsFile << "Algorithm=" << mCurrentAlgorithm << std::endl;
     settingsFile << "NumColors=" << mNumColors << std::endl;
     settingsFile << "FillDirection=" << mFillDirection << std::endl;
+    settingsFile << "BoardShape=" << mBoardShape << std::endl;
     settingsFile << "GameDifficulty=" << mGameDifficulty << std::endl;
     settingsFile.close();
 }
@@ -148,6 +309,7 @@ void Game::loadSettings() {
             else if (key == "Algorithm") mCurrentAlgorithm = (AlgorithmType)value;
             else if (key == "NumColors") mNumColors = value;
             else if (key == "FillDirection") mFillDirection = (FillDirection)value;
+            else if (key == "BoardShape" && value >= SHAPE_SQUARE && value <= SHAPE_MASKED) mBoardShape = (BoardShape)value;
             else if (key == "GameDifficulty") mGameDifficulty = (GameDifficulty)value;
         }
     }
@@ -220,32 +382,69 @@ GameState* Game::getTopState() {
 
 
 void Game::handleEvents() {
+    TRACE_SCOPE("Game::handleEvents");
     SDL_Event e;
     while (SDL_PollEvent(&e) != 0) {
         if (e.type == SDL_QUIT) {
             requestQuit();
         }
+        if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+            mRenderResetCount++;
+        }
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3 && e.key.repeat == 0) {
+            mShowMemoryOverlay = !mShowMemoryOverlay;
+            continue;
+        }
         if (!mStates.empty()) {
+            TRACE_SCOPE_ARG("GameState::handleEvents", "state", mStates.back()->getName());
             mStates.back()->handleEvents(e);
         }
     }
 }
 
 void Game::update() {
+    TRACE_SCOPE("Game::update");
     if (!mStates.empty()) {
+        TRACE_SCOPE_ARG("GameState::update", "state", mStates.back()->getName());
         mStates.back()->update();
     }
 }
 
 void Game::draw() {
+    TRACE_SCOPE("Game::draw");
     SDL_SetRenderDrawColor(mRenderer, BG_COLOR.r, BG_COLOR.g, BG_COLOR.b, 255);
     SDL_RenderClear(mRenderer);
 
     for (GameState* state : mStates) {
+        TRACE_SCOPE_ARG("GameState::draw", "state", state->getName());
         state->draw(mRenderer);
     }
 
-    SDL_RenderPresent(mRenderer);
+    if (mShowMemoryOverlay) drawMemoryOverlay();
+
+    {
+        TRACE_SCOPE("SDL_RenderPresent");
+        SDL_RenderPresent(mRenderer);
+    }
+}
+
+void Game::drawMemoryOverlay() {
+    TTF_Font* font = mResourceManager.getFontSmall();
+    if (!font) return;
+    std::vector<std::string> lines = MemoryStats::formatLines();
+    const int lineHeight = TTF_FontLineSkip(font);
+
+    SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 180);
+    SDL_Rect box = { 5, 5, 330, lineHeight * ((int)lines.size() + 1) + 10 };
+    SDL_RenderFillRect(mRenderer, &box);
+
+    int y = box.y + 5 + lineHeight / 2;
+    drawTextLeft(mRenderer, "Memory (current / peak)", box.x + 8, y, font, TEXT_WHITE);
+    for (const std::string& line : lines) {
+        y += lineHeight;
+        drawTextLeft(mRenderer, line, box.x + 8, y, font, TEXT_WHITE);
+    }
 }
 
 void Game::checkForSaveFile() {
@@ -255,7 +454,7 @@ void Game::checkForSaveFile() {
 }
 
 void Game::deleteSaveFile() {
-    remove("savegame.txt");
+    if (!mHeadless) remove("savegame.txt");
     mSaveFileExists = false;
 }
 
@@ -272,6 +471,7 @@ void Game::loadHighestLevel() {
 }
 
 void Game::saveHighestLevel() {
+    if (mHeadless) return;
     std::ofstream levelFile("level_data.txt");
     if (levelFile.is_open()) {
         levelFile << mHighestLevel;
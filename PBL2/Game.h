@@ -2,8 +2,14 @@
 
 #include <vector>
 #include <string>
+#include <utility>
+#include <chrono>
+#include <memory>
 #include "Constants.h"
 #include "ResourceManager.h"
+#include "Random.h"
+#include "LevelPack.h"
+#include "HeadlessRunner.h"
 #include <SDL_mixer.h>
 
 class GameState;
@@ -158,6 +164,18 @@ public:
      */
     FillDirection getFillDirection() const { return mFillDirection; }
 
+    /**
+     * @brief Đặt dạng bàn cờ (ô vuông, hình xuyến, lục giác, có lỗ).
+     * @param shape Dạng bàn cờ.
+     */
+    void setBoardShape(BoardShape shape) { mBoardShape = shape; }
+
+    /**
+     * @brief Lấy dạng bàn cờ hiện tại.
+     * @return Dạng bàn cờ.
+     */
+    BoardShape getBoardShape() const { return mBoardShape; }
+
     /**
      * @brief Đặt số lượng màu sắc trong game.
      * @param colors Số lượng màu.
@@ -200,6 +218,81 @@ public:
      */
     float getDifficultyModifier() const;
 
+    /**
+     * @brief Kích thước lưới của một màn chơi.
+     * @param level Số thứ tự màn chơi (bắt đầu từ 1).
+     * @return Số ô mỗi cạnh.
+     */
+    static int getGridDimForLevel(int level) { return std::min(6 + (level - 1) * 2, 40); }
+
+    /**
+     * @brief Giới hạn số bước tạm tính theo công thức (dùng khi chưa giải thử được màn chơi).
+     */
+    int getFormulaMaxMoves(int gridDim, int numColors) const;
+
+    /**
+     * @brief Giới hạn số bước từ độ dài lời giải của solver, cộng thêm phần dư theo độ khó.
+     * @param solutionMoves Số bước của lời giải tìm được.
+     */
+    int getMaxMovesForSolution(int solutionMoves) const;
+
+    /**
+     * @brief Đặt seed cho phiên chơi (gọi trước init()). Nếu không đặt, seed lấy theo thời gian.
+     * @param seed Seed của phiên.
+     */
+    void setSeed(uint64_t seed) { mSeed = seed; mHasExplicitSeed = true; }
+
+    /**
+     * @brief Bật chế độ không màn hình (gọi trước init()): dùng driver video/âm thanh dummy của SDL,
+     * phát lại kịch bản nhập liệu và ghi thời gian từng khung hình ra reportPath khi kết thúc.
+     * @return false nếu không đọc được kịch bản.
+     */
+    bool enableHeadless(const std::string& scriptPath, const std::string& reportPath);
+
+    /**
+     * @brief Kịch bản chạy không màn hình có lệnh nào thất bại không (dùng làm mã thoát).
+     */
+    bool hasHeadlessFailed() const { return mHeadless && mHeadless->hasFailed(); }
+
+    /**
+     * @brief Đang chạy theo kịch bản không màn hình. Khi đó không ghi hay xóa file cài đặt, tiến độ và file lưu.
+     */
+    bool isHeadless() const { return mHeadless != nullptr; }
+
+    /**
+     * @brief Lấy seed của phiên chơi hiện tại (in ra khi khởi động để tái hiện lỗi).
+     * @return Seed của phiên.
+     */
+    uint64_t getSeed() const { return mSeed; }
+
+    /**
+     * @brief Bộ sinh cho hiệu ứng (glitch, mạng điểm, âm thanh, seed các hệ hạt), tách từ seed của phiên lúc khởi động.
+     * Rút số từ đây không làm đổi seed các màn chơi.
+     */
+    Random& getEffectsRandom() { return mEffectsRandom; }
+
+    /**
+     * @brief Seed cho lần bắt đầu màn level tiếp theo: chỉ phụ thuộc vào seed của phiên, số màn và
+     * số lần đã bắt đầu màn trong phiên (không phụ thuộc số khung hình hay hiệu ứng đã chạy).
+     */
+    uint64_t nextLevelSeed(int level);
+
+    /**
+     * @brief Seed cho map của lần đua AI tiếp theo (theo seed của phiên và số lần đua trong phiên).
+     */
+    uint64_t nextAIMapSeed();
+
+    /**
+     * @brief Số lần render target/thiết bị render bị reset. Các state giữ texture vẽ sẵn
+     * so sánh giá trị này để biết khi nào phải tạo lại.
+     */
+    int getRenderResetCount() const { return mRenderResetCount; }
+
+    /**
+     * @brief Lấy level pack đã nạp (có thể chưa mở nếu không có file levels.pack).
+     */
+    const LevelPack& getLevelPack() const { return mLevelPack; }
+
 private:
     /**
      * @brief Xử lý các sự kiện đầu vào (chuột, bàn phím).
@@ -221,6 +314,28 @@ private:
      */
     void close();
 
+    /**
+     * @brief Vẽ thanh tiến trình trong lúc ResourceManager tải tài nguyên trên luồng nền.
+     *
+     * Chưa có font nên chỉ vẽ hình khối; vẫn xử lý SDL_QUIT để cửa sổ không bị treo.
+     */
+    void runLoadingScreen();
+
+    /**
+     * @brief Ghi nhận thời gian của giai đoạn khởi động vừa xong (tính từ lần ghi trước).
+     */
+    void markStartupPhase(const char* name);
+
+    /**
+     * @brief In bảng thời gian khởi động và ghi thêm một dòng vào STARTUP_LOG_FILE (gọi sau khung hình đầu).
+     */
+    void reportStartup();
+
+    /**
+     * @brief Vẽ bảng bộ nhớ theo nhóm (hiện tại / đỉnh) ở góc trên trái, bật tắt bằng F3.
+     */
+    void drawMemoryOverlay();
+
     bool mIsRunning; ///< Cờ kiểm soát vòng lặp game.
     SDL_Window* mWindow; ///< Con trỏ tới cửa sổ game.
     SDL_Renderer* mRenderer; ///< Con trỏ tới renderer để vẽ.
@@ -231,7 +346,25 @@ private:
     int mHighestLevel; ///< Màn chơi cao nhất người chơi đã đạt được.
     AlgorithmType mCurrentAlgorithm; ///< Thuật toán AI đang được sử dụng.
     FillDirection mFillDirection; ///< Hướng tô màu của AI.
+    BoardShape mBoardShape; ///< Dạng bàn cờ của màn mới.
     int mNumColors; ///< Số lượng màu trong màn chơi AI.
 
     GameDifficulty mGameDifficulty; ///< Độ khó hiện tại của game.
+
+    uint64_t mSeed; ///< Seed của phiên chơi.
+    bool mHasExplicitSeed; ///< Cờ báo seed được đặt từ dòng lệnh.
+    Random mEffectsRandom; ///< Bộ sinh của hiệu ứng, tách từ mSeed (xem getEffectsRandom()).
+    int mLevelRunCount; ///< Số lần đã bắt đầu một màn chơi trong phiên.
+    int mAIRunCount; ///< Số lần đã đua AI trên map sinh ngẫu nhiên trong phiên.
+    LevelPack mLevelPack; ///< Các màn chơi sinh sẵn, map từ file levels.pack.
+
+    std::chrono::steady_clock::time_point mStartupBegin; ///< Lúc bắt đầu init().
+    std::chrono::steady_clock::time_point mStartupMark; ///< Lúc kết thúc giai đoạn khởi động gần nhất.
+    std::vector<std::pair<std::string, double>> mStartupPhases; ///< Tên giai đoạn và thời gian (ms).
+    bool mStartupReported; ///< Đã ghi báo cáo khởi động sau khung hình đầu chưa.
+    int mRenderResetCount; ///< Tăng khi nhận SDL_RENDER_TARGETS_RESET hoặc SDL_RENDER_DEVICE_RESET.
+    bool mShowMemoryOverlay; ///< Hiện bảng MemoryStats (phím F3).
+
+    std::unique_ptr<HeadlessRunner> mHeadless; ///< Khác null khi chạy không màn hình theo kịch bản.
+    std::string mFrameReportPath; ///< File CSV thời gian từng khung hình của chế độ không màn hình.
 };
\ No newline at end of file
@@ -22,13 +22,13 @@ void GameOverState::initButtons() {
     int centerY = SCREEN_HEIGHT / 2;
 
     if (mGameWon) {
-        mUI.addButton("next_level", { centerX - 125, centerY, 250, 60 }, "game_over_next_level", BUTTON_GREEN, BUTTON_HIGHLIGHT);
+        mUI.addButton("next_level", { centerX - 125, centerY, 250, 60 }, TXT_GAME_OVER_NEXT_LEVEL, BUTTON_GREEN, BUTTON_HIGHLIGHT);
     }
     else {
-        mUI.addButton("retry_game", { centerX - 125, centerY, 250, 60 }, "game_over_retry_game", BUTTON_BLUE, BUTTON_HIGHLIGHT);
+        mUI.addButton("retry_game", { centerX - 125, centerY, 250, 60 }, TXT_GAME_OVER_RETRY_GAME, BUTTON_BLUE, BUTTON_HIGHLIGHT);
     }
-    mUI.addButton("retry_level", { centerX - 125, centerY + 70, 250, 60 }, "game_over_retry_level", BUTTON_YELLOW, BUTTON_HIGHLIGHT);
-    mUI.addButton("menu", { centerX - 125, centerY + 140, 250, 60 }, "game_over_menu", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("retry_level", { centerX - 125, centerY + 70, 250, 60 }, TXT_GAME_OVER_RETRY_LEVEL, BUTTON_YELLOW, BUTTON_HIGHLIGHT);
+    mUI.addButton("menu", { centerX - 125, centerY + 140, 250, 60 }, TXT_GAME_OVER_MENU, BUTTON_GRAY, BUTTON_HIGHLIGHT);
     mUI.updateButtonTexts();
 }
 
@@ -38,14 +38,12 @@ void GameOverState::handleEvents(SDL_Event& e) {
 
     if (action == "next_level") {
         int nextLevel = mPlayerLevel + 1;
-        int gridDim = 6 + (nextLevel - 1) * 2; gridDim = std::min(gridDim, 40);
+        int gridDim = Game::getGridDimForLevel(nextLevel);
         int numColors = mGame->getNumColors();
-
-        float modifier = mGame->getDifficultyModifier();
-        int maxMoves = static_cast<int>((gridDim * gridDim * numColors) / (gridDim * modifier) + 5);
+        int maxMoves = mGame->getFormulaMaxMoves(gridDim, numColors);
 
         mGame->popAndChange(new PlayingState(mGame, mGame->getResources(), nextLevel, gridDim, numColors, maxMoves,
-            mGame->getAlgorithm(), mGame->getFillDirection()));
+            mGame->getAlgorithm(), mGame->getFillDirection(), mGame->getBoardShape()));
     }
     else if (action == "retry_game") {
         int level = 1;
@@ -53,14 +51,12 @@ void GameOverState::handleEvents(SDL_Event& e) {
         mGame->saveHighestLevel();
         mGame->deleteSaveFile();
 
-        int gridDim = 6 + (level - 1) * 2;
+        int gridDim = Game::getGridDimForLevel(level);
         int numColors = mGame->getNumColors();
-
-        float modifier = mGame->getDifficultyModifier();
-        int maxMoves = static_cast<int>((gridDim * gridDim * numColors) / (gridDim * modifier) + 5);
+        int maxMoves = mGame->getFormulaMaxMoves(gridDim, numColors);
 
         mGame->popAndChange(new PlayingState(mGame, mGame->getResources(), level, gridDim, numColors, maxMoves,
-            mGame->getAlgorithm(), mGame->getFillDirection()));
+            mGame->getAlgorithm(), mGame->getFillDirection(), mGame->getBoardShape()));
     }
     else if (action == "retry_level") {
         mGame->popAndRetry();
@@ -85,12 +81,12 @@ void GameOverState::draw(SDL_Renderer* renderer) {
     int centerX = mapOffsetX + MAP_AREA_SIZE / 2;
     int centerY = mapOffsetY + MAP_AREA_SIZE / 2;
 
-    std::string msg = mGameWon ? res->getText("game_over_win") : res->getText("game_over_lose");
+    std::string_view msg = mGameWon ? res->getText(TXT_GAME_OVER_WIN) : res->getText(TXT_GAME_OVER_LOSE);
     drawText(renderer, msg, centerX, centerY - 120, res->getFontTitle(), { 255,255,0,255 });
 
     if (mGameWon) {
         std::stringstream ss;
-        ss << res->getText("game_over_time") << " " << static_cast<int>(mTime) << " " << res->getText("game_over_seconds");
+        ss << res->getText(TXT_GAME_OVER_TIME) << " " << static_cast<int>(mTime) << " " << res->getText(TXT_GAME_OVER_SECONDS);
         drawText(renderer, ss.str(), centerX, centerY - 50, res->getFontUI(), TEXT_WHITE);
     }
 
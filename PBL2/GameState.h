@@ -3,6 +3,7 @@
 #include <SDL.h>
 
 class Game;
+class UIManager;
 
 /**
  * @class GameState
@@ -41,6 +42,22 @@ public:
      */
     virtual void draw(SDL_Renderer* renderer) = 0;
 
+    /**
+     * @brief Tên của trạng thái, dùng trong báo cáo thời gian khung hình và kịch bản chạy không màn hình.
+     */
+    virtual const char* getName() const { return "GameState"; }
+
+    /**
+     * @brief Bộ quản lý nút của trạng thái (nếu có), để kịch bản nhấn nút theo khóa.
+     */
+    virtual UIManager* getUI() { return nullptr; }
+
+    /**
+     * @brief Tọa độ màn hình của tâm ô (gx, gy) nếu trạng thái có lưới để nhấn vào.
+     * @return false nếu trạng thái không có lưới hoặc ô nằm ngoài lưới.
+     */
+    virtual bool getCellCenter(int /*gx*/, int /*gy*/, int& /*x*/, int& /*y*/) const { return false; }
+
 protected:
     Game* mGame; ///< Con trỏ tới đối tượng Game chính để truy cập các chức năng toàn cục.
 };
\ No newline at end of file
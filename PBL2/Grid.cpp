@@ -1,9 +1,13 @@
 ﻿#include "Grid.h"
-#include <cstdlib>#include <set>
+#include "Trace.h"
 
 Grid::Grid()
-    : mDim(0), mNumColors(0), mCellSize(0), mMapOffsetX(0), mMapOffsetY(0),
-    mAlgoType(ALGO_BFS), mFillDir(DIR_FOUR), mIsAnimating(false)
+    : mDim(0), mNumColors(0), mCellSize(0), mMapOffsetX(0), mMapOffsetY(0), mInitialCells(makeBoardSnapshot(Board())),
+    mAlgoType(ALGO_BFS), mTopology(Topology::create(SHAPE_SQUARE, DIR_FOUR, 0)), mIsAnimating(false),
+    mPacer(FILL_ANIMATION_MS, FILL_FRAME_BUDGET_MS), mReplayDone(0),
+    mColorCounts(PALETTE.size(), 0), mTargetIndex(-1), mReplacementIndex(-1),
+    mRevision(1), mControlledRegionRevision(0), mControlledRegionSize(0), mOutlineRevision(0),
+    mCellsCharge(MEM_GRID)
 {
     mTargetColor = { 0,0,0,0 };
     mReplacementColor = { 0,0,0,0 };
@@ -11,105 +15,204 @@ Grid::Grid()
 
 void Grid::recalculateRenderParams() {
     if (mDim == 0) return;
-    mCellSize = MAP_AREA_SIZE / mDim;
-    mMapOffsetX = (SCREEN_WIDTH - UI_PANEL_WIDTH - MAP_AREA_SIZE) / 2;
+    mCellSize = mTopology->fitCellSize(MAP_AREA_SIZE);
+    // Bàn lục giác rộng hơn nửa ô nên căn giữa theo bề rộng thật thay vì MAP_AREA_SIZE
+    mMapOffsetX = (SCREEN_WIDTH - UI_PANEL_WIDTH - mTopology->getBoardWidth(mCellSize)) / 2;
     mMapOffsetY = (SCREEN_HEIGHT - MAP_AREA_SIZE) / 2;
 }
 
-void Grid::init(int dim, int numColors, AlgorithmType algo, FillDirection fillDir) {
-    mDim = dim;
+void Grid::configure(int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed) {
+    mTopology = std::move(topology);
+    mDim = mTopology->getDim();
     mNumColors = numColors;
     mAlgoType = algo;
-    mFillDir = fillDir;
     mIsAnimating = false;
+    mFiller.cancel();
+    mFiller.resetStats();
     recalculateRenderParams();
-    generateMap();
-    mInitialCells = mCells;
+    mRandom.setSeed(seed);
     mPendingChangeCells.clear();
 }
 
+void Grid::init(int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed) {
+    configure(numColors, algo, std::move(topology), seed);
+    generateMap();
+    mInitialRandom = mRandom;
+    mInitialCells = makeBoardSnapshot(mCells);
+}
+
+void Grid::load(BoardSnapshot initial, Board current, int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed) {
+    configure(numColors, algo, std::move(topology), seed);
+    // generateMap() rút đúng một số cho mỗi ô; bỏ qua từng ấy số để sự kiện đổi màu khớp với init()
+    for (int i = 0; i < mDim * mDim; ++i) mRandom.next();
+    mInitialRandom = mRandom;
+    mInitialCells = std::move(initial);
+    mCells = std::move(current);
+    syncDisplayCells();
+    recountColors();
+}
+
+void Grid::load(BoardSnapshot initial, int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed) {
+    Board current = *initial;
+    load(std::move(initial), std::move(current), numColors, algo, std::move(topology), seed);
+}
+
 void Grid::generateMap() {
     mCells.assign(mDim, std::vector<SDL_Color>(mDim));
     for (int y = 0; y < mDim; ++y) {
         for (int x = 0; x < mDim; ++x) {
-            mCells[x][y] = PALETTE[rand() % mNumColors];
+            mCells[x][y] = PALETTE[mRandom.nextInt(mNumColors)];
         }
     }
+    syncDisplayCells();
+    recountColors();
 }
 
-void Grid::setGrid(const std::vector<std::vector<SDL_Color>>& grid) {
-    mCells = grid;
-    if (!grid.empty()) {
-        mDim = (int)grid.size();
-    }
-    else {
-        mDim = 0;
+void Grid::recountColors() {
+    markChanged();
+    updateMemoryCharge();
+    std::fill(mColorCounts.begin(), mColorCounts.end(), 0);
+    // Ô bị khoét vẫn giữ một màu trong mCells (để map sinh từ seed không đổi) nhưng không được đếm
+    for (int x = 0; x < (int)mCells.size(); ++x) {
+        for (int y = 0; y < (int)mCells[x].size(); ++y) {
+            if (!mTopology->isActive(x, y)) continue;
+            int index = getPaletteIndex(mCells[x][y]);
+            if (index >= 0) mColorCounts[index]++;
+        }
     }
-    recalculateRenderParams();
-    mIsAnimating = false;
-    mPendingChangeCells.clear();
 }
 
-void Grid::setInitialGrid(const std::vector<std::vector<SDL_Color>>& grid) {
-    mInitialCells = grid;
+// Bỏ hoạt ảnh đang phát, hiển thị đúng mCells (sau khi lưới được thay toàn bộ)
+void Grid::syncDisplayCells() {
+    mDisplayCells = mCells;
+    mReplay.clear();
+    mReplayDone = 0;
+    mIsAnimating = false;
 }
 
+void Grid::recordFilledCells(int count) {
+    TRACE_COUNTER("cells_filled", count);
+    if (count == 0) return;
+    markChanged();
+    if (mTargetIndex >= 0) mColorCounts[mTargetIndex] -= count;
+    if (mReplacementIndex >= 0) mColorCounts[mReplacementIndex] += count;
+}
 
 void Grid::resetToInitial() {
-    mCells = mInitialCells;
-    mIsAnimating = false;
+    mCells = *mInitialCells;
+    mRandom = mInitialRandom;
+    syncDisplayCells();
+    recountColors();
+    mFiller.cancel();
     mPendingChangeCells.clear();
 }
 
-std::vector<std::vector<bool>> Grid::findControlledRegion() const {
-    std::vector<std::vector<bool>> visited(mDim, std::vector<bool>(mDim, false));
-    if (mCells.empty()) return visited;
-
-    std::queue<std::pair<int, int>> q;
-    SDL_Color targetColor = mCells[0][0];
-
-    q.push({ 0, 0 });
-    visited[0][0] = true;
-
-    int dx4[] = { 0, 0, 1, -1 };
-    int dy4[] = { 1, -1, 0, 0 };
-    int dx8[] = { 0, 0, 1, -1, 1, 1, -1, -1 };
-    int dy8[] = { 1, -1, 0, 0, 1, -1, 1, -1 };
-    int directions = (mFillDir == DIR_FOUR) ? 4 : 8;
-    int* dx = (mFillDir == DIR_FOUR) ? dx4 : dx8;
-    int* dy = (mFillDir == DIR_FOUR) ? dy4 : dy8;
-
-    while (!q.empty()) {
-        std::pair<int, int> curr = q.front(); q.pop();
-        int x = curr.first; int y = curr.second;
-
-        for (int i = 0; i < directions; ++i) {
-            int nx = x + dx[i]; int ny = y + dy[i];
-            if (nx >= 0 && nx < mDim && ny >= 0 && ny < mDim &&
-                !visited[nx][ny] && areColorsEqual(mCells[nx][ny], targetColor)) {
-                visited[nx][ny] = true;
-                q.push({ nx, ny });
-            }
+const std::vector<std::vector<bool>>& Grid::findControlledRegion() const {
+    if (mControlledRegionRevision == mRevision) return mControlledRegion;
+    mControlledRegionRevision = mRevision;
+
+    mControlledRegionSize = FloodFill::regionFromOrigin(mCells, *mTopology, mControlledRegion, mScratch);
+    return mControlledRegion;
+}
+
+int Grid::getControlledRegionSize() const {
+    findControlledRegion();
+    return mControlledRegionSize;
+}
+
+// Dò đường biên vùng đang chiếm: mỗi cạnh ô giáp ô ngoài vùng thành một cạnh có hướng
+// (đi theo chiều kim đồng hồ quanh vùng), rồi nối các cạnh thành vòng khép kín và chỉ giữ lại các góc.
+// Chi phí tỉ lệ với chu vi khi vẽ; việc dò chỉ chạy lại khi lưới thay đổi.
+// Bàn lục giác được dò trên lưới nửa ô: mỗi ô rộng 2 cột và hàng lẻ lệch 1 cột, đúng như khi vẽ.
+void Grid::traceControlledOutline() const {
+    if (mOutlineRevision == mRevision) return;
+    const auto& region = findControlledRegion();
+    mOutlineRevision = mRevision;
+    mOutlinePoints.clear();
+    mOutlineLoopStarts.clear();
+    if (mDim <= 0) return;
+
+    const bool hex = mTopology->getShape() == SHAPE_HEX;
+    const int span = hex ? 2 : 1;
+    const int width = mDim * span + (hex ? 1 : 0);
+
+    // Mỗi đỉnh có tối đa 2 cạnh đi ra (khi hai ô của vùng chỉ chạm nhau ở góc)
+    const int stride = width + 1;
+    std::vector<int> out((size_t)stride * (mDim + 1) * 2, -1);
+    auto inside = [&](int x, int y) {
+        if (y < 0 || y >= mDim) return false;
+        x -= (hex && (y & 1)) ? 1 : 0;
+        if (x < 0) return false;
+        x /= span;
+        return x < mDim && region[x][y];
+    };
+    auto addEdge = [&](int fromX, int fromY, int toX, int toY) {
+        size_t slot = (size_t)(fromY * stride + fromX) * 2;
+        out[out[slot] < 0 ? slot : slot + 1] = toY * stride + toX;
+    };
+
+    for (int y = 0; y < mDim; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (!inside(x, y)) continue;
+            if (!inside(x, y - 1)) addEdge(x, y, x + 1, y);             // Cạnh trên
+            if (!inside(x + 1, y)) addEdge(x + 1, y, x + 1, y + 1);     // Cạnh phải
+            if (!inside(x, y + 1)) addEdge(x + 1, y + 1, x, y + 1);     // Cạnh dưới
+            if (!inside(x - 1, y)) addEdge(x, y + 1, x, y);             // Cạnh trái
         }
     }
-    return visited;
+
+    for (size_t slot = 0; slot < out.size(); ++slot) {
+        if (out[slot] < 0) continue;
+        const int start = (int)(slot / 2);
+        const int loopStart = (int)mOutlinePoints.size();
+        mOutlineLoopStarts.push_back(loopStart);
+
+        int v = start, prevDx = 0, prevDy = 0;
+        do {
+            int* edges = &out[(size_t)v * 2];
+            int s = (edges[0] >= 0) ? 0 : 1;
+            int next = edges[s];
+            edges[s] = -1;
+
+            int dx = next % stride - v % stride;
+            int dy = next / stride - v / stride;
+            if (dx != prevDx || dy != prevDy) { // Chỉ lưu đỉnh ở chỗ đổi hướng
+                mOutlinePoints.push_back({ v % stride, v / stride });
+            }
+            prevDx = dx; prevDy = dy;
+            v = next;
+        } while (v != start);
+
+        mOutlinePoints.push_back(mOutlinePoints[loopStart]); // Khép vòng
+    }
+}
+
+void Grid::drawControlledOutline(SDL_Renderer* renderer) const {
+    traceControlledOutline();
+    if (mOutlinePoints.empty()) return;
+
+    const int span = (mTopology->getShape() == SHAPE_HEX) ? 2 : 1;
+    mOutlineScreenPoints.resize(mOutlinePoints.size());
+    for (size_t i = 0; i < mOutlinePoints.size(); ++i) {
+        mOutlineScreenPoints[i].x = mMapOffsetX + mOutlinePoints[i].x * mCellSize / span;
+        mOutlineScreenPoints[i].y = mMapOffsetY + mOutlinePoints[i].y * mCellSize;
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
+    for (size_t i = 0; i < mOutlineLoopStarts.size(); ++i) {
+        int begin = mOutlineLoopStarts[i];
+        int end = (i + 1 < mOutlineLoopStarts.size()) ? mOutlineLoopStarts[i + 1] : (int)mOutlinePoints.size();
+        SDL_RenderDrawLines(renderer, &mOutlineScreenPoints[begin], end - begin);
+    }
 }
 
 void Grid::draw(SDL_Renderer* renderer, bool showControlledRegion, bool showStartHint, bool showEventWarning) const {
     drawInViewport(renderer, mMapOffsetX, mMapOffsetY, mCellSize);
 
-    if (showControlledRegion) {
-        auto controlledRegion = findControlledRegion();
-        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
-        for (int y = 0; y < mDim; ++y) {
-            for (int x = 0; x < mDim; ++x) {
-                if (controlledRegion[x][y]) {
-                    SDL_Rect cellRect = { mMapOffsetX + x * mCellSize, mMapOffsetY + y * mCellSize, mCellSize, mCellSize };
-                    SDL_RenderDrawRect(renderer, &cellRect);
-                }
-            }
-        }
+    // Lưới đã là trạng thái sau nước đi nên chỉ vẽ đường biên khi hoạt ảnh phát xong
+    if (showControlledRegion && !mIsAnimating) {
+        drawControlledOutline(renderer);
     }
 
     if (showStartHint && SDL_GetTicks() % 1000 < 500) {
@@ -124,7 +227,7 @@ void Grid::draw(SDL_Renderer* renderer, bool showControlledRegion, bool showStar
             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 100);
             for (const auto& cellPos : mPendingChangeCells) {
                 SDL_Rect highlightRect = {
-                    mMapOffsetX + cellPos.first * mCellSize,
+                    mMapOffsetX + mTopology->getRowShift(cellPos.second, mCellSize) + cellPos.first * mCellSize,
                     mMapOffsetY + cellPos.second * mCellSize,
                     mCellSize, mCellSize
                 };
@@ -135,126 +238,137 @@ void Grid::draw(SDL_Renderer* renderer, bool showControlledRegion, bool showStar
 }
 
 void Grid::drawInViewport(SDL_Renderer* renderer, int startX, int startY, int cellSize) const {
-    SDL_Rect cellRect = { 0, 0, cellSize, cellSize };
-    for (int y = 0; y < mDim; ++y) {
-        for (int x = 0; x < mDim; ++x) {
-            cellRect.x = startX + x * cellSize;
-            cellRect.y = startY + y * cellSize;
-            SDL_SetRenderDrawColor(renderer, mCells[x][y].r, mCells[x][y].g, mCells[x][y].b, 255);
-            SDL_RenderFillRect(renderer, &cellRect);
+    drawCells(renderer, mDisplayCells, *mTopology, startX, startY, cellSize);
+}
+
+// Gộp các ô liền nhau cùng màu trên một hàng thành một hình chữ nhật, gom theo màu trong PALETTE
+// rồi vẽ mỗi màu bằng một lần SDL_RenderFillRects. Màn cuối gần như một màu nên số lệnh vẽ giảm từ N² xuống
+// còn khoảng số đoạn chạy. Đoạn chạy dừng ở ô bị khoét (để trống) và hàng lẻ của bàn lục giác lệch nửa ô.
+// Bộ đệm là static: hàm chỉ được gọi từ luồng vẽ.
+void Grid::drawCells(SDL_Renderer* renderer, const std::vector<std::vector<SDL_Color>>& cells, const Topology& topology,
+    int startX, int startY, int cellSize) {
+    static std::vector<std::vector<SDL_Rect>> runsByColor;
+    runsByColor.resize(PALETTE.size());
+    for (auto& runs : runsByColor) runs.clear();
+
+    int dim = std::min((int)cells.size(), topology.getDim());
+    for (int y = 0; y < dim; ++y) {
+        int rowX = startX + topology.getRowShift(y, cellSize);
+        int x = 0;
+        while (x < dim) {
+            if (!topology.isActive(x, y)) { ++x; continue; }
+            const SDL_Color& color = cells[x][y];
+            int runEnd = x + 1;
+            while (runEnd < dim && topology.isActive(runEnd, y) && areColorsEqual(cells[runEnd][y], color)) ++runEnd;
+
+            SDL_Rect run = { rowX + x * cellSize, startY + y * cellSize, (runEnd - x) * cellSize, cellSize };
+            int colorIndex = getPaletteIndex(color);
+            if (colorIndex >= 0) {
+                runsByColor[colorIndex].push_back(run);
+            }
+            else { // Màu ngoài bảng màu: vẽ riêng
+                SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, 255);
+                SDL_RenderFillRect(renderer, &run);
+            }
+            x = runEnd;
         }
     }
+
+    for (size_t i = 0; i < runsByColor.size(); ++i) {
+        const auto& runs = runsByColor[i];
+        if (runs.empty()) continue;
+        SDL_SetRenderDrawColor(renderer, PALETTE[i].r, PALETTE[i].g, PALETTE[i].b, 255);
+        SDL_RenderFillRects(renderer, runs.data(), (int)runs.size());
+    }
 }
 
 
 bool Grid::startFloodFill(const SDL_Color& newColor) {
+    TRACE_SCOPE("Grid::startFloodFill");
     if (mCells.empty() || areColorsEqual(mCells[0][0], newColor)) return false;
 
-
     mTargetColor = mCells[0][0];
     mReplacementColor = newColor;
-    mIsAnimating = true;
+    mTargetIndex = getPaletteIndex(mTargetColor);
+    mReplacementIndex = getPaletteIndex(mReplacementColor);
 
     if (mAlgoType == ALGO_UNION_FIND) {
-        DSU dsu(mDim * mDim);
-        for (int y = 0; y < mDim; ++y) {
-            for (int x = 0; x < mDim; ++x) {
-                if (areColorsEqual(mCells[x][y], mTargetColor)) {
-                    if (x + 1 < mDim && areColorsEqual(mCells[x + 1][y], mTargetColor)) dsu.unite(y * mDim + x, y * mDim + x + 1);
-                    if (y + 1 < mDim && areColorsEqual(mCells[x][y + 1], mTargetColor)) dsu.unite(y * mDim + x, (y + 1) * mDim + x);
-                    if (mFillDir == DIR_EIGHT) {
-                        if (x + 1 < mDim && y + 1 < mDim && areColorsEqual(mCells[x + 1][y + 1], mTargetColor)) dsu.unite(y * mDim + x, (y + 1) * mDim + x + 1);
-                        if (x - 1 >= 0 && y + 1 < mDim && areColorsEqual(mCells[x - 1][y + 1], mTargetColor)) dsu.unite(y * mDim + x, (y + 1) * mDim + x - 1);
-                    }
-                }
-            }
-        }
-        int startRoot = dsu.find(0);
-        for (int y = 0; y < mDim; ++y) {
-            for (int x = 0; x < mDim; ++x) {
-                if (dsu.find(y * mDim + x) == startRoot) mCells[x][y] = mReplacementColor;
-            }
-        }
-        mIsAnimating = false;
+        skipFillAnimation(); // Ghi thẳng vào lưới hiển thị nên nước trước phải hiện hết
+        auto write = [this](int x, int y) {
+            mCells[x][y] = mReplacementColor;
+            mDisplayCells[x][y] = mReplacementColor;
+        };
+        int filled = mFiller.fillUnionFind(mCells, *mTopology, write);
+        recordFilledCells(filled);
+        TRACE_COUNTER("fill_peak_container", mFiller.getStats().peakContainer);
     }
     else {
-        while (!mBfsQueue.empty()) mBfsQueue.pop();
-        while (!mDfsStack.empty()) mDfsStack.pop();
-        while (!mScanlineStack.empty()) mScanlineStack.pop();
-
-        if (mAlgoType == ALGO_BFS) mBfsQueue.push({ 0, 0 });
-        else if (mAlgoType == ALGO_DFS) mDfsStack.push({ 0, 0 });
-        else if (mAlgoType == ALGO_SCANLINE) mScanlineStack.push({ 0, 0 });
+        // Tô xong ngay trong một lần, chỉ ghi lại thứ tự ô của thuật toán để phát lại thành hoạt ảnh.
+        // Nước đi khi hoạt ảnh trước còn chạy được nối vào sau phần chưa phát, rồi cả hai phát chung một lượt.
+        mReplay.erase(mReplay.begin(), mReplay.begin() + mReplayDone);
+        mReplayDone = 0;
+        auto write = [this](int x, int y) {
+            mCells[x][y] = mReplacementColor;
+            mReplay.push_back({ (uint32_t)(x * mDim + y), mReplacementColor });
+        };
+        mFiller.begin(mAlgoType, mTargetColor, 0, 0);
+        int filled = mFiller.fillAll(mCells, *mTopology, write);
+        recordFilledCells(filled);
+        TRACE_COUNTER("fill_replay", mReplay.size());
+        TRACE_COUNTER("fill_peak_container", mFiller.getStats().peakContainer);
+        mPacer.begin((int)mReplay.size());
+        mIsAnimating = !mReplay.empty();
     }
     return true;
 }
 
 bool Grid::animateFillStep() {
     if (!mIsAnimating) return true;
-
-    int steps = 0;
-    bool animationEnded = false;
-    switch (mAlgoType) {
-    case ALGO_BFS:
-    case ALGO_DFS: {
-        auto& q_or_s = (mAlgoType == ALGO_BFS) ? (void*&)mBfsQueue : (void*&)mDfsStack;
-        while ((mAlgoType == ALGO_BFS ? !mBfsQueue.empty() : !mDfsStack.empty()) && steps < STEPS_PER_FRAME) {
-            std::pair<int, int> curr;
-            if (mAlgoType == ALGO_BFS) { curr = mBfsQueue.front(); mBfsQueue.pop(); }
-            else { curr = mDfsStack.top(); mDfsStack.pop(); }
-            int x = curr.first, y = curr.second;
-            if (x < 0 || x >= mDim || y < 0 || y >= mDim || !areColorsEqual(mCells[x][y], mTargetColor)) continue;
-            mCells[x][y] = mReplacementColor;
-
-            int dx4[] = { 1, -1, 0, 0 };
-            int dy4[] = { 0, 0, 1, -1 };
-            int dx8[] = { 1, -1, 0, 0, 1, -1, 1, -1 };
-            int dy8[] = { 0, 0, 1, -1, 1, 1, -1, -1 };
-            int directions = (mFillDir == DIR_FOUR) ? 4 : 8;
-            int* dx = (mFillDir == DIR_FOUR) ? dx4 : dx8;
-            int* dy = (mFillDir == DIR_FOUR) ? dy4 : dy8;
-
-            for (int i = 0; i < directions; ++i) {
-                if (mAlgoType == ALGO_BFS) mBfsQueue.push({ x + dx[i], y + dy[i] }); else mDfsStack.push({ x + dx[i], y + dy[i] });
-            }
-            steps++;
-        }
-        if (mAlgoType == ALGO_BFS ? mBfsQueue.empty() : mDfsStack.empty()) animationEnded = true;
-    } break;
-    case ALGO_SCANLINE:
-        while (!mScanlineStack.empty() && steps < 1) {
-            std::pair<int, int> curr = mScanlineStack.top(); mScanlineStack.pop();
-            int x = curr.first, y = curr.second;
-            if (y < 0 || y >= mDim || !areColorsEqual(mCells[x][y], mTargetColor)) continue;
-            int west = x; while (west > 0 && areColorsEqual(mCells[west - 1][y], mTargetColor)) west--;
-            int east = x; while (east < mDim - 1 && areColorsEqual(mCells[east + 1][y], mTargetColor)) east++;
-            for (int i = west; i <= east; ++i) {
-                mCells[i][y] = mReplacementColor;
-                if (y > 0 && areColorsEqual(mCells[i][y - 1], mTargetColor)) mScanlineStack.push({ i, y - 1 });
-                if (y < mDim - 1 && areColorsEqual(mCells[i][y + 1], mTargetColor)) mScanlineStack.push({ i, y + 1 });
-            }
-            steps++;
+    TRACE_SCOPE("Grid::animateFillStep");
+
+    // Chép từng phần tới chỉ tiêu của khung hình, dừng sớm khi hết ngân sách thời gian
+    mPacer.beginFrame();
+    int chunk;
+    while (mReplayDone < mReplay.size() && (chunk = mPacer.nextChunk()) > 0) {
+        auto chunkStart = std::chrono::steady_clock::now();
+        size_t end = std::min(mReplay.size(), mReplayDone + (size_t)chunk);
+        int cells = (int)(end - mReplayDone);
+        for (; mReplayDone < end; ++mReplayDone) {
+            const ReplayCell& cell = mReplay[mReplayDone];
+            mDisplayCells[cell.index / mDim][cell.index % mDim] = cell.color;
         }
-        if (mScanlineStack.empty()) animationEnded = true;
-        break;
-    default:
-        animationEnded = true;
-        break;
+        mPacer.record(cells, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - chunkStart).count());
     }
 
-    if (animationEnded) {
-        mIsAnimating = false;
-        return true;
+    TRACE_COUNTER("fill_replay_remaining", mReplay.size() - mReplayDone);
+    if (mReplayDone < mReplay.size()) return false;
+    mReplay.clear();
+    mReplayDone = 0;
+    mIsAnimating = false;
+    return true;
+}
+
+void Grid::skipFillAnimation() {
+    for (; mReplayDone < mReplay.size(); ++mReplayDone) {
+        const ReplayCell& cell = mReplay[mReplayDone];
+        mDisplayCells[cell.index / mDim][cell.index % mDim] = cell.color;
     }
-    return false;
+    mReplay.clear();
+    mReplayDone = 0;
+    mIsAnimating = false;
 }
 
 bool Grid::isWinConditionMet() const {
     if (mCells.empty()) return false;
+    // Thắng khi màu của người chơi phủ đủ mọi ô của bàn cờ: so sánh O(1) với bảng đếm theo màu
+    int playerIndex = getPaletteIndex(mCells[0][0]);
+    if (playerIndex >= 0) {
+        return mColorCounts[playerIndex] == mTopology->getCellCount();
+    }
     const SDL_Color& firstColor = mCells[0][0];
     for (int y = 0; y < mDim; ++y) {
         for (int x = 0; x < mDim; ++x) {
-            if (!areColorsEqual(mCells[x][y], firstColor)) {
+            if (mTopology->isActive(x, y) && !areColorsEqual(mCells[x][y], firstColor)) {
                 return false;
             }
         }
@@ -268,123 +382,49 @@ PredictionResult Grid::predictProgress() const {
         return { true, 0, 0 };
     }
 
-    std::set<SDL_Color, ColorComparator> remainingColorsSet;
-    for (int y = 0; y < mDim; ++y) {
-        for (int x = 0; x < mDim; ++x) {
-            remainingColorsSet.insert(mCells[x][y]);
-        }
+    // Đếm các màu còn lại từ bảng đếm theo màu: O(số màu) thay vì duyệt toàn bộ lưới
+    int playerIndex = getPaletteIndex(mCells[0][0]);
+    int remainingColors = 0;
+    for (int i = 0; i < (int)mColorCounts.size(); ++i) {
+        if (i != playerIndex && mColorCounts[i] > 0) remainingColors++;
     }
 
-    SDL_Color playerColor = mCells[0][0];
-    remainingColorsSet.erase(playerColor);
-
-    result.predictedSteps = (int)remainingColorsSet.size();
-    result.remainingColors = (int)remainingColorsSet.size();
+    result.predictedSteps = remainingColors;
+    result.remainingColors = remainingColors;
     return result;
 }
 
-int Grid::countConnectedRegion(const std::vector<std::vector<SDL_Color>>& grid) const {
-    int dim = (int)grid.size();
-    if (dim == 0) return 0;
-    std::vector<std::vector<bool>> visited(dim, std::vector<bool>(dim, false));
-    std::queue<std::pair<int, int>> q;
-    int count = 0;
-    SDL_Color targetColor = grid[0][0];
-
-    q.push({ 0,0 });
-    visited[0][0] = true;
-    while (!q.empty()) {
-        std::pair<int, int> curr = q.front(); q.pop();
-        count++;
-        int x = curr.first; int y = curr.second;
-
-        int dx4[] = { 0,0,1,-1 };
-        int dy4[] = { 1,-1,0,0 };
-        int dx8[] = { 0, 0, 1, -1, 1, 1, -1, -1 };
-        int dy8[] = { 1, -1, 0, 0, 1, -1, 1, -1 };
-        int directions = (mFillDir == DIR_FOUR) ? 4 : 8;
-        int* dx = (mFillDir == DIR_FOUR) ? dx4 : dx8;
-        int* dy = (mFillDir == DIR_FOUR) ? dy4 : dy8;
-
-        for (int i = 0; i < directions; ++i) {
-            int nx = x + dx[i]; int ny = y + dy[i];
-            if (nx >= 0 && nx < dim && ny >= 0 && ny < dim && !visited[nx][ny] && areColorsEqual(grid[nx][ny], targetColor)) {
-                visited[nx][ny] = true;
-                q.push({ nx,ny });
-            }
-        }
-    }
-    return count;
-}
-
-
 SDL_Color Grid::findBestMove() const {
-    SDL_Color bestColor = mCells[0][0];
-    int maxConnected = -1;
-    SDL_Color startColor = mCells[0][0];
-
-    for (int i = 0; i < mNumColors; ++i) {
-        SDL_Color currentColor = PALETTE[i];
-        if (areColorsEqual(currentColor, startColor)) continue;
-
-        std::vector<std::vector<SDL_Color>> tempGrid = mCells;
-        std::queue<std::pair<int, int>> flood_q;
-        flood_q.push({ 0, 0 });
-        std::vector<std::vector<bool>> visited(mDim, std::vector<bool>(mDim, false));
-        visited[0][0] = true;
-
-        while (!flood_q.empty()) {
-            std::pair<int, int> p = flood_q.front(); flood_q.pop();
-            tempGrid[p.first][p.second] = currentColor;
-
-            int dx4[] = { 0, 0, 1, -1 };
-            int dy4[] = { 1, -1, 0, 0 };
-            int dx8[] = { 0, 0, 1, -1, 1, 1, -1, -1 };
-            int dy8[] = { 1, -1, 0, 0, 1, -1, 1, -1 };
-            int directions = (mFillDir == DIR_FOUR) ? 4 : 8;
-            int* dx = (mFillDir == DIR_FOUR) ? dx4 : dx8;
-            int* dy = (mFillDir == DIR_FOUR) ? dy4 : dy8;
-
-            for (int k = 0; k < directions; ++k) {
-                int nx = p.first + dx[k];
-                int ny = p.second + dy[k];
-                if (nx >= 0 && nx < mDim && ny >= 0 && ny < mDim && !visited[nx][ny] && areColorsEqual(mCells[nx][ny], startColor)) {
-                    visited[nx][ny] = true;
-                    flood_q.push({ nx, ny });
-                }
-            }
-        }
-
-        int connectedSize = countConnectedRegion(tempGrid);
-
-        if (connectedSize > maxConnected) {
-            maxConnected = connectedSize;
-            bestColor = currentColor;
-        }
-    }
-    return bestColor;
+    TRACE_SCOPE("Grid::findBestMove");
+    if (mCells.empty()) return { 0,0,0,0 };
+    int bestIndex = FloodFill::bestMove(mCells, *mTopology, PALETTE.data(), mNumColors, mScratch);
+    return bestIndex >= 0 ? PALETTE[bestIndex] : mCells[0][0];
 }
 
 void Grid::selectRandomCellsForChangeEvent(int count) {
     mPendingChangeCells.clear();
-    std::vector<std::pair<int, int>> allCells;
-    for (int y = 0; y < mDim; ++y) {
-        for (int x = 0; x < mDim; ++x) {
-            allCells.push_back({ x, y });
-        }
-    }
-    if (allCells.empty()) return;
-
-    std::random_shuffle(allCells.begin(), allCells.end());
-
-    count = std::min(count, (int)allCells.size());
-
-    for (int i = 0; i < count; ++i) {
-        mPendingChangeCells.push_back(allCells[i]);
+    int total = mTopology->getCellCount();
+    if (total == 0 || count <= 0) return;
+    count = std::min(count, total);
+
+    // Thuật toán Floyd: chọn count ô phân biệt trong O(count), không duyệt hay xáo trộn toàn bộ N^2 ô.
+    // Chỉ số được đếm trên các ô thuộc bàn cờ nên bàn có lỗ vẫn đủ count ô (bàn không lỗ cho đúng các ô như trước).
+    // count chỉ vài ô nên tập đã chọn là một mảng sắp xếp, tra bằng tìm kiếm nhị phân thay vì bảng băm
+    std::vector<int> chosen;
+    chosen.reserve(count);
+    for (int j = total - count; j < total; ++j) {
+        int t = mRandom.nextInt(j + 1);
+        auto it = std::lower_bound(chosen.begin(), chosen.end(), t);
+        int pick = (it != chosen.end() && *it == t) ? j : t;
+        if (pick == j) chosen.push_back(j); // Mọi ô đã chọn đều < j nên mảng vẫn sắp xếp
+        else chosen.insert(it, t);
+        uint32_t index = mTopology->getActiveCell(pick);
+        mPendingChangeCells.push_back({ (int)(index / mDim), (int)(index % mDim) });
     }
 }
 
 bool Grid::executeColorChangeEvent() {
+    TRACE_SCOPE("Grid::executeColorChangeEvent");
     if (mPendingChangeCells.empty()) return false;
 
     for (const auto& cell : mPendingChangeCells) {
@@ -393,30 +433,42 @@ bool Grid::executeColorChangeEvent() {
         SDL_Color currentColor = mCells[x][y];
         SDL_Color newColor;
         do {
-            newColor = PALETTE[rand() % mNumColors];
+            newColor = PALETTE[mRandom.nextInt(mNumColors)];
         } while (areColorsEqual(newColor, currentColor));
-        mCells[x][y] = newColor;
+        setCellColor(x, y, newColor);
     }
 
     mPendingChangeCells.clear();
     return true;
 }
 
+void Grid::setCellColor(int x, int y, const SDL_Color& color) {
+    skipFillAnimation(); // Ô này có thể còn trong hoạt ảnh, phát nốt để không bị ghi đè màu cũ
+    int oldIndex = getPaletteIndex(mCells[x][y]);
+    int newIndex = getPaletteIndex(color);
+    markChanged();
+    if (oldIndex >= 0) mColorCounts[oldIndex]--;
+    if (newIndex >= 0) mColorCounts[newIndex]++;
+    mCells[x][y] = color;
+    mDisplayCells[x][y] = color;
+}
+
 SDL_Color Grid::getColorFromClick(int mX, int mY) const {
-    if (!isClickInBounds(mX, mY)) {
+    int gridX, gridY;
+    if (!mTopology->cellAt(mX - mMapOffsetX, mY - mMapOffsetY, mCellSize, gridX, gridY)) {
         return { 0,0,0,0 };
     }
-    int gridX = (mX - mMapOffsetX) / mCellSize;
-    int gridY = (mY - mMapOffsetY) / mCellSize;
-    if (gridX >= 0 && gridX < mDim && gridY >= 0 && gridY < mDim) {
-        return mCells[gridX][gridY];
-    }
-    return { 0,0,0,0 };
+    return mCells[gridX][gridY];
 }
 
 bool Grid::isClickInBounds(int mX, int mY) const {
-    if (mCellSize == 0) return false;
-    int gridX = (mX - mMapOffsetX) / mCellSize;
-    int gridY = (mY - mMapOffsetY) / mCellSize;
-    return gridX >= 0 && gridX < mDim && gridY >= 0 && gridY < mDim;
-}
\ No newline at end of file
+    int gridX, gridY;
+    return mTopology->cellAt(mX - mMapOffsetX, mY - mMapOffsetY, mCellSize, gridX, gridY);
+}
+
+bool Grid::getCellCenter(int gx, int gy, int& x, int& y) const {
+    if (!mTopology->isActive(gx, gy) || mCellSize == 0) return false;
+    x = mMapOffsetX + mTopology->getRowShift(gy, mCellSize) + gx * mCellSize + mCellSize / 2;
+    y = mMapOffsetY + gy * mCellSize + mCellSize / 2;
+    return true;
+}
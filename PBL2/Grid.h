@@ -1,10 +1,33 @@
 ﻿#pragma once
 
 #include "Constants.h"
-#include "DSU.h"
-#include <queue>
-#include <stack>
+#include "FillPacer.h"
+#include "FloodFill.h"
+#include "MemoryStats.h"
+#include "Random.h"
+#include "Topology.h"
 #include <algorithm>
+#include <memory>
+
+typedef std::vector<std::vector<SDL_Color>> Board;
+
+/**
+ * @brief Lưới bất biến dùng chung theo đếm tham chiếu.
+ *
+ * Lưới ban đầu của một màn chỉ được tạo một lần rồi chia sẻ giữa Grid, các AISolver và luồng
+ * giải thử, thay vì mỗi nơi giữ một bản sao. Bộ nhớ được tính vào MEM_GRID một lần cho mỗi snapshot.
+ */
+typedef std::shared_ptr<const Board> BoardSnapshot;
+
+inline BoardSnapshot makeBoardSnapshot(Board cells) {
+    long long bytes = (long long)nestedVectorBytes(cells);
+    MemoryStats::add(MEM_GRID, bytes);
+    return BoardSnapshot(new Board(std::move(cells)), [bytes](const Board* board) {
+        MemoryStats::add(MEM_GRID, -bytes);
+        delete board;
+    });
+}
+
 class Grid {
 private:
     int mDim;
@@ -12,39 +35,99 @@ private:
     int mCellSize;
     int mMapOffsetX, mMapOffsetY;
 
-    std::vector<std::vector<SDL_Color>> mCells;
-    std::vector<std::vector<SDL_Color>> mInitialCells;
+    Board mCells;
+    BoardSnapshot mInitialCells; // Lưới lúc bắt đầu màn (dùng chung, không bao giờ sửa)
 
     AlgorithmType mAlgoType;
-    FillDirection mFillDir;
+    TopologyRef mTopology; // Dạng bàn cờ và danh sách lân cận (dùng chung, không bao giờ sửa)
 
     bool mIsAnimating;
     SDL_Color mTargetColor, mReplacementColor;
-    std::queue<std::pair<int, int>> mBfsQueue;
-    std::stack<std::pair<int, int>> mDfsStack;
-    std::stack<std::pair<int, int>> mScanlineStack;
+    FloodFill::Filler<SDL_Color> mFiller; // Trạng thái tô từng bước, dùng chung kernel với AISolver
+    FillPacer mPacer;                     // Chia việc phát lại theo thời lượng mục tiêu và ngân sách mỗi khung hình
+
+    // mCells luôn là lưới sau nước đi; mDisplayCells là lưới đang hiển thị. Hoạt ảnh chép dần các ô
+    // trong mReplay (chỉ số x * mDim + y, theo thứ tự của thuật toán đang chọn) từ mReplayDone sang mDisplayCells.
+    // Các nước đi liên tiếp trong lúc hoạt ảnh chạy được nối đuôi nhau trong cùng danh sách.
+    struct ReplayCell {
+        uint32_t index;
+        SDL_Color color;
+    };
+    Board mDisplayCells;
+    std::vector<ReplayCell> mReplay;
+    size_t mReplayDone;
 
     std::vector<std::pair<int, int>> mPendingChangeCells;
 
-    int countConnectedRegion(const std::vector<std::vector<SDL_Color>>& grid) const;
+    // Số ô của từng màu trong PALETTE, cập nhật dần theo mỗi lần tô, sự kiện và hoàn tác
+    std::vector<int> mColorCounts;
+    int mTargetIndex, mReplacementIndex;
+
+    // Vùng đang chiếm được tính lại chỉ khi lưới thay đổi (theo số phiên bản mRevision)
+    unsigned int mRevision;
+    mutable unsigned int mControlledRegionRevision;
+    mutable std::vector<std::vector<bool>> mControlledRegion;
+    mutable int mControlledRegionSize;
+
+    // Đường biên vùng đang chiếm theo tọa độ đỉnh lưới, dựng lại khi mRevision đổi (bàn lục giác dùng lưới
+    // nửa ô theo chiều ngang). Các vòng khép kín nằm nối tiếp trong mOutlinePoints (điểm đầu được lặp lại ở cuối mỗi vòng).
+    mutable unsigned int mOutlineRevision;
+    mutable std::vector<SDL_Point> mOutlinePoints;
+    mutable std::vector<int> mOutlineLoopStarts;
+    mutable std::vector<SDL_Point> mOutlineScreenPoints; // Bộ đệm đổi sang tọa độ màn hình khi vẽ
+
+    // Bộ nhớ tạm dùng lại cho tìm vùng và findBestMove (Grid chỉ được dùng trên một luồng)
+    mutable FloodFill::Scratch mScratch;
+
+    Random mRandom;        // Bộ sinh riêng của màn chơi (sinh map + sự kiện đổi màu)
+    Random mInitialRandom; // Trạng thái bộ sinh ngay sau khi sinh map, dùng khi chơi lại màn
+
+    MemoryCharge mCellsCharge; // Số byte của mCells và mDisplayCells trong MemoryStats (mInitialCells tự tính khi tạo snapshot)
+
     void recalculateRenderParams();
+    void configure(int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed);
+    void recountColors();
+    void recordFilledCells(int count);
+    void markChanged() { ++mRevision; }
+    void updateMemoryCharge() { mCellsCharge.set(nestedVectorBytes(mCells) + nestedVectorBytes(mDisplayCells)); }
+    void syncDisplayCells();
+    void traceControlledOutline() const;
+    void drawControlledOutline(SDL_Renderer* renderer) const;
 
 public:
     Grid();
-    void init(int dim, int numColors, AlgorithmType algo, FillDirection fillDir);
+    void init(int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed);
+
+    /**
+     * @brief Như init() nhưng dùng lưới có sẵn thay vì sinh map (màn từ level pack, file lưu, cuộc đua AI).
+     *
+     * Bộ sinh được đặt như thể đã sinh map từ seed, nên sự kiện đổi màu giống hệt init() cùng seed.
+     * Bản có current nhận luôn lưới đang chơi; bản không có thì sao chép từ initial.
+     * Cả hai lưới phải có cùng cỡ với topology.
+     */
+    void load(BoardSnapshot initial, Board current, int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed);
+    void load(BoardSnapshot initial, int numColors, AlgorithmType algo, TopologyRef topology, uint64_t seed);
 
     void generateMap();
-    void setGrid(const std::vector<std::vector<SDL_Color>>& grid);
-    void setInitialGrid(const std::vector<std::vector<SDL_Color>>& grid);
     void resetToInitial();
 
     void draw(SDL_Renderer* renderer, bool showControlledRegion, bool showStartHint, bool showEventWarning) const;
     void drawInViewport(SDL_Renderer* renderer, int startX, int startY, int cellSize) const;
+    static void drawCells(SDL_Renderer* renderer, const std::vector<std::vector<SDL_Color>>& cells, const Topology& topology,
+        int startX, int startY, int cellSize);
 
-    std::vector<std::vector<bool>> findControlledRegion() const;
+    const std::vector<std::vector<bool>>& findControlledRegion() const;
+    int getControlledRegionSize() const;
+    unsigned int getRevision() const { return mRevision; }
+    void setMemoryTag(MemoryTag tag) { mCellsCharge.setTag(tag); }
 
     bool startFloodFill(const SDL_Color& newColor);
-    bool animateFillStep();
+    bool animateFillStep();                 // Phát tiếp phần của khung hình này theo FillPacer; true khi đã phát xong
+    void skipFillAnimation();               // Hiện ngay toàn bộ nước vừa đi
+    void setFillPacing(double targetMs, double budgetMs) { mPacer.configure(targetMs, budgetMs); }
+    const Board& getDisplayCells() const { return mDisplayCells; } // Lưới như đang hiển thị (các ô chưa phát tới giữ màu cũ)
+    const FloodFill::FillStats& getFillStats() const { return mFiller.getStats(); }
+    void resetFillStats() { mFiller.resetStats(); }
 
     bool isWinConditionMet() const;
     PredictionResult predictProgress() const;
@@ -55,13 +138,17 @@ public:
     const std::vector<std::pair<int, int>>& getPendingChangeCells() const { return mPendingChangeCells; }
 
     const std::vector<std::vector<SDL_Color>>& getCells() const { return mCells; }
-    std::vector<std::vector<SDL_Color>>& getCells_NonConst() { return mCells; }
 
-    void setCells(const std::vector<std::vector<SDL_Color>>& cells) { mCells = cells; }
-    const std::vector<std::vector<SDL_Color>>& getInitialCells() const { return mInitialCells; }
+    void setCells(Board cells) { mCells = std::move(cells); syncDisplayCells(); recountColors(); }
+    void setCellColor(int x, int y, const SDL_Color& color); // Điểm ghi duy nhất cho thay đổi từng ô
+    const std::vector<int>& getColorCounts() const { return mColorCounts; }
+    const Board& getInitialCells() const { return *mInitialCells; }
+    const BoardSnapshot& getInitialSnapshot() const { return mInitialCells; }
     SDL_Color getColorFromClick(int mX, int mY) const;
     bool isClickInBounds(int mX, int mY) const;
+    bool getCellCenter(int gx, int gy, int& x, int& y) const; // Tọa độ màn hình của tâm ô
     int getDim() const { return mDim; }
+    const TopologyRef& getTopology() const { return mTopology; }
     bool isAnimating() const { return mIsAnimating; }
 
 };
\ No newline at end of file
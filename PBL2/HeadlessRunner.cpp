@@ -0,0 +1,277 @@
+﻿#include "HeadlessRunner.h"
+#include "Game.h"
+#include "GameState.h"
+#include "MemoryStats.h"
+#include "UIManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+    // Số tham số tối thiểu của từng lệnh
+    const std::map<std::string, int> COMMAND_ARGS = {
+        { "wait", 1 }, { "click", 2 }, { "cell", 2 }, { "button", 1 }, { "key", 1 },
+        { "text", 1 }, { "expect", 1 }, { "wait_state", 1 }, { "repeat", 1 }, { "end", 0 }, { "quit", 0 }
+    };
+
+    double percentile(std::vector<double> values, double p) {
+        if (values.empty()) return 0.0;
+        size_t k = (size_t)(p * (values.size() - 1) + 0.5);
+        std::nth_element(values.begin(), values.begin() + k, values.end());
+        return values[k];
+    }
+}
+
+bool HeadlessRunner::loadScript(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Không thể mở kịch bản " << path << "!" << std::endl;
+        return false;
+    }
+
+    // Khối repeat được trải phẳng ngay khi đọc
+    std::vector<std::vector<Command>> blocks(1);
+    std::vector<int> repeatCounts;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(file, line)) {
+        ++lineNo;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::istringstream in(line);
+        Command cmd;
+        cmd.line = lineNo;
+        if (!(in >> cmd.name) || cmd.name[0] == '#') continue;
+
+        auto it = COMMAND_ARGS.find(cmd.name);
+        if (it == COMMAND_ARGS.end()) {
+            std::cerr << path << ":" << lineNo << ": lệnh không hợp lệ '" << cmd.name << "'" << std::endl;
+            return false;
+        }
+        if (cmd.name == "text") {
+            std::string rest;
+            std::getline(in >> std::ws, rest);
+            if (!rest.empty()) cmd.args.push_back(rest);
+        }
+        else {
+            std::string arg;
+            while (in >> arg) cmd.args.push_back(arg);
+        }
+        if ((int)cmd.args.size() < it->second) {
+            std::cerr << path << ":" << lineNo << ": thiếu tham số cho '" << cmd.name << "'" << std::endl;
+            return false;
+        }
+
+        if (cmd.name == "repeat") {
+            repeatCounts.push_back(std::max(0, std::atoi(cmd.args[0].c_str())));
+            blocks.emplace_back();
+        }
+        else if (cmd.name == "end") {
+            if (repeatCounts.empty()) {
+                std::cerr << path << ":" << lineNo << ": 'end' không có 'repeat' tương ứng" << std::endl;
+                return false;
+            }
+            std::vector<Command> body = std::move(blocks.back());
+            blocks.pop_back();
+            for (int i = 0; i < repeatCounts.back(); ++i) {
+                blocks.back().insert(blocks.back().end(), body.begin(), body.end());
+            }
+            repeatCounts.pop_back();
+        }
+        else {
+            blocks.back().push_back(cmd);
+        }
+    }
+    if (!repeatCounts.empty()) {
+        std::cerr << path << ": thiếu 'end' cho 'repeat'" << std::endl;
+        return false;
+    }
+
+    mCommands = std::move(blocks[0]);
+    mNextCommand = 0;
+    return true;
+}
+
+void HeadlessRunner::beginFrame(Game& game) {
+    GameState* top = game.getTopState();
+
+    if (!mWaitState.empty()) {
+        if (top && mWaitState == top->getName()) {
+            mWaitState.clear();
+        }
+        else if (--mWaitStateFrames <= 0) {
+            std::cerr << "Kịch bản: hết thời gian chờ state " << mWaitState << std::endl;
+            mFailed = true;
+            mWaitState.clear();
+            mNextCommand = mCommands.size();
+            return;
+        }
+        else {
+            return;
+        }
+    }
+
+    if (mWaitFrames > 0) {
+        --mWaitFrames;
+        return;
+    }
+
+    if (mNextCommand < mCommands.size()) {
+        const Command& cmd = mCommands[mNextCommand++];
+        if (!execute(game, cmd)) mNextCommand = mCommands.size();
+    }
+}
+
+bool HeadlessRunner::execute(Game& game, const Command& cmd) {
+    GameState* top = game.getTopState();
+    const std::vector<std::string>& a = cmd.args;
+
+    if (cmd.name == "wait") {
+        mWaitFrames = std::max(0, std::atoi(a[0].c_str()) - 1);
+    }
+    else if (cmd.name == "click") {
+        pushClick(std::atoi(a[0].c_str()), std::atoi(a[1].c_str()));
+    }
+    else if (cmd.name == "cell") {
+        int x = 0, y = 0;
+        if (!top || !top->getCellCenter(std::atoi(a[0].c_str()), std::atoi(a[1].c_str()), x, y)) {
+            std::cerr << "Kịch bản dòng " << cmd.line << ": bỏ qua 'cell', state hiện tại không có lưới hoặc ô ngoài lưới" << std::endl;
+            return true;
+        }
+        pushClick(x, y);
+    }
+    else if (cmd.name == "button") {
+        UIManager* ui = top ? top->getUI() : nullptr;
+        Button* button = ui ? ui->getButton(a[0]) : nullptr;
+        if (!button) {
+            std::cerr << "Kịch bản dòng " << cmd.line << ": bỏ qua 'button', không có nút " << a[0] << std::endl;
+            return true;
+        }
+        const SDL_Rect& r = button->getRect();
+        pushClick(r.x + r.w / 2, r.y + r.h / 2);
+    }
+    else if (cmd.name == "key") {
+        if (!pushKey(a[0])) fail(cmd, "không nhận ra phím " + a[0]);
+    }
+    else if (cmd.name == "text") {
+        pushText(a.empty() ? std::string() : a[0]);
+    }
+    else if (cmd.name == "expect") {
+        if (!top || a[0] != top->getName()) {
+            fail(cmd, "cần state " + a[0] + " nhưng đang ở " + (top ? top->getName() : "(trống)"));
+            return false;
+        }
+    }
+    else if (cmd.name == "wait_state") {
+        mWaitState = a[0];
+        mWaitStateFrames = (a.size() > 1) ? std::atoi(a[1].c_str()) : 600;
+    }
+    else if (cmd.name == "quit") {
+        return false;
+    }
+    return true;
+}
+
+void HeadlessRunner::fail(const Command& cmd, const std::string& message) {
+    std::cerr << "Kịch bản dòng " << cmd.line << ": " << message << std::endl;
+    mFailed = true;
+}
+
+void HeadlessRunner::pushClick(int x, int y) {
+    SDL_Event e;
+    std::memset(&e, 0, sizeof(e));
+    e.type = SDL_MOUSEMOTION;
+    e.motion.x = x; e.motion.y = y;
+    SDL_PushEvent(&e);
+
+    std::memset(&e, 0, sizeof(e));
+    e.type = SDL_MOUSEBUTTONDOWN;
+    e.button.button = SDL_BUTTON_LEFT;
+    e.button.x = x; e.button.y = y;
+    SDL_PushEvent(&e);
+
+    e.type = SDL_MOUSEBUTTONUP;
+    SDL_PushEvent(&e);
+}
+
+bool HeadlessRunner::pushKey(const std::string& spec) {
+    std::string name = spec;
+    Uint16 mod = KMOD_NONE;
+    if (name.compare(0, 5, "ctrl+") == 0) { mod |= KMOD_LCTRL; name = name.substr(5); }
+    if (name.compare(0, 6, "shift+") == 0) { mod |= KMOD_LSHIFT; name = name.substr(6); }
+
+    SDL_Keycode key = SDL_GetKeyFromName(name.c_str());
+    if (key == SDLK_UNKNOWN) return false;
+
+    SDL_Event e;
+    std::memset(&e, 0, sizeof(e));
+    e.type = SDL_KEYDOWN;
+    e.key.keysym.sym = key;
+    e.key.keysym.mod = mod;
+    SDL_PushEvent(&e);
+
+    e.type = SDL_KEYUP;
+    SDL_PushEvent(&e);
+    return true;
+}
+
+void HeadlessRunner::pushText(const std::string& text) {
+    SDL_Event e;
+    std::memset(&e, 0, sizeof(e));
+    e.type = SDL_TEXTINPUT;
+    SDL_strlcpy(e.text.text, text.c_str(), sizeof(e.text.text));
+    SDL_PushEvent(&e);
+}
+
+void HeadlessRunner::recordFrame(const char* stateName, double updateMs, double drawMs) {
+    mFrames.push_back({ stateName, updateMs, drawMs });
+}
+
+bool HeadlessRunner::writeReport(const std::string& path) const {
+    std::ofstream csv(path);
+    if (!csv.is_open()) {
+        std::cerr << "Không thể ghi " << path << "!" << std::endl;
+        return false;
+    }
+    csv << "frame,state,update_ms,draw_ms\n" << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < mFrames.size(); ++i) {
+        csv << i << "," << mFrames[i].state << "," << mFrames[i].updateMs << "," << mFrames[i].drawMs << "\n";
+    }
+
+    // Tóm tắt theo từng state, giữ thứ tự xuất hiện
+    std::vector<std::string> order;
+    std::map<std::string, std::vector<double>> totals;
+    std::vector<double> all;
+    for (const FrameSample& f : mFrames) {
+        if (!totals.count(f.state)) order.push_back(f.state);
+        totals[f.state].push_back(f.updateMs + f.drawMs);
+        all.push_back(f.updateMs + f.drawMs);
+    }
+    order.push_back("(all)");
+    totals["(all)"] = all;
+
+    std::cout << "Thời gian khung hình (update + draw, ms), chi tiết trong " << path << ":\n";
+    std::cout << std::left << std::setw(20) << "state" << std::right << std::setw(8) << "frames"
+        << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p95" << std::setw(10) << "p99"
+        << std::setw(10) << "max" << "\n" << std::fixed << std::setprecision(3);
+    for (const std::string& name : order) {
+        const std::vector<double>& v = totals[name];
+        if (v.empty()) continue;
+        double sum = 0.0;
+        for (double t : v) sum += t;
+        std::cout << std::left << std::setw(20) << name << std::right << std::setw(8) << v.size()
+            << std::setw(10) << sum / v.size() << std::setw(10) << percentile(v, 0.50)
+            << std::setw(10) << percentile(v, 0.95) << std::setw(10) << percentile(v, 0.99)
+            << std::setw(10) << *std::max_element(v.begin(), v.end()) << "\n";
+    }
+    std::cout << "Bộ nhớ theo nhóm (hiện tại / đỉnh):\n";
+    for (const std::string& line : MemoryStats::formatLines()) {
+        std::cout << "  " << line << "\n";
+    }
+    std::cout << (mFailed ? "Kịch bản: THẤT BẠI" : "Kịch bản: OK") << std::endl;
+    return true;
+}
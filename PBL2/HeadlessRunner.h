@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+class Game;
+
+/**
+ * @class HeadlessRunner
+ * @brief Chạy game không cần màn hình: phát lại một kịch bản nhập liệu và đo thời gian từng khung hình.
+ *
+ * Kịch bản là file văn bản, mỗi dòng một lệnh (dòng trống và dòng bắt đầu bằng # bị bỏ qua):
+ *   wait N                  Chờ N khung hình.
+ *   click X Y               Nhấn chuột trái tại tọa độ màn hình.
+ *   cell GX GY              Nhấn vào ô (GX, GY) của lưới ở state trên cùng.
+ *   button KEY              Nhấn vào giữa nút KEY của UIManager ở state trên cùng.
+ *   key [ctrl+]NAME         Nhấn phím theo tên của SDL (ví dụ: Return, Escape, ctrl+z).
+ *   text CHUỖI              Gửi SDL_TEXTINPUT.
+ *   expect STATE            Báo lỗi nếu state trên cùng không phải STATE.
+ *   wait_state STATE [N]    Chờ tới khi state trên cùng là STATE (tối đa N khung hình, mặc định 600).
+ *   repeat N ... end        Lặp khối lệnh N lần.
+ *   quit                    Kết thúc (cũng tự kết thúc khi hết kịch bản).
+ *
+ * Mỗi lệnh nhập liệu được đẩy vào hàng đợi sự kiện SDL ở đầu một khung hình, nên đi qua đúng
+ * đường Game::handleEvents như khi chơi thật.
+ */
+class HeadlessRunner {
+public:
+    HeadlessRunner() : mNextCommand(0), mWaitFrames(0), mWaitStateFrames(0), mFailed(false) {}
+
+    /**
+     * @brief Đọc kịch bản từ file.
+     * @return false nếu không mở được file hoặc có dòng sai cú pháp.
+     */
+    bool loadScript(const std::string& path);
+
+    /**
+     * @brief Gọi ở đầu mỗi khung hình: thực hiện lệnh kế tiếp của kịch bản (nếu không phải đang chờ).
+     */
+    void beginFrame(Game& game);
+
+    /**
+     * @brief Ghi lại thời gian của khung hình vừa chạy.
+     */
+    void recordFrame(const char* stateName, double updateMs, double drawMs);
+
+    bool isFinished() const { return mNextCommand >= mCommands.size() && mWaitFrames <= 0 && mWaitState.empty(); }
+    bool hasFailed() const { return mFailed; }
+
+    /**
+     * @brief Ghi CSV thời gian từng khung hình và in bảng tóm tắt theo từng state.
+     */
+    bool writeReport(const std::string& path) const;
+
+private:
+    struct Command {
+        std::string name;
+        std::vector<std::string> args;
+        int line;
+    };
+
+    struct FrameSample {
+        const char* state;
+        double updateMs;
+        double drawMs;
+    };
+
+    bool execute(Game& game, const Command& cmd);
+    void fail(const Command& cmd, const std::string& message);
+
+    static void pushClick(int x, int y);
+    static bool pushKey(const std::string& spec);
+    static void pushText(const std::string& text);
+
+    std::vector<Command> mCommands;
+    size_t mNextCommand;
+    int mWaitFrames;
+    std::string mWaitState;
+    int mWaitStateFrames;
+    bool mFailed;
+    std::vector<FrameSample> mFrames;
+};
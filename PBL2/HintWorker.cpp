@@ -0,0 +1,94 @@
+﻿#include "HintWorker.h"
+#include "MoveSearch.h"
+#include "Trace.h"
+
+HintWorker::HintWorker()
+    : mHasJob(false), mQuit(false), mGeneration(0), mRequestedRevision(0),
+    mHasResult(false), mResultRevision(0), mResultDepth(0)
+{
+    mResultColor = { 0,0,0,0 };
+    mThread = std::thread(&HintWorker::run, this);
+}
+
+HintWorker::~HintWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQuit = true;
+        ++mGeneration;
+    }
+    mCondition.notify_one();
+    if (mThread.joinable()) mThread.join();
+}
+
+void HintWorker::request(const std::vector<std::vector<SDL_Color>>& cells, TopologyRef topology, int numColors, unsigned int revision) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mPendingJob.cells = cells;
+        mPendingJob.topology = std::move(topology);
+        mPendingJob.numColors = numColors;
+        mPendingJob.revision = revision;
+        mPendingJob.generation = ++mGeneration;
+        mHasJob = true;
+    }
+    mRequestedRevision = revision;
+    mCondition.notify_one();
+}
+
+void HintWorker::cancel() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    ++mGeneration;
+    mHasJob = false;
+    mRequestedRevision = 0;
+}
+
+bool HintWorker::getHint(unsigned int revision, SDL_Color& color, int* depth) const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!mHasResult || mResultRevision != revision) return false;
+    color = mResultColor;
+    if (depth) *depth = mResultDepth;
+    return true;
+}
+
+void HintWorker::run() {
+    TRACE_THREAD_NAME("HintWorker");
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this] { return mQuit || mHasJob; });
+            if (mQuit) return;
+            job = std::move(mPendingJob);
+            mHasJob = false;
+        }
+        solve(job);
+    }
+}
+
+void HintWorker::solve(const Job& job) {
+    if (job.cells.empty() || !job.topology) return;
+    TRACE_SCOPE("HintWorker::solve");
+    auto cancelled = [this, &job] { return mGeneration.load() != job.generation; };
+
+    // Nước tham lam trước để nút Gợi ý có kết quả gần như ngay lập tức
+    const Topology& topology = *job.topology;
+    int greedy = FloodFill::bestMove(job.cells, topology, PALETTE.data(), job.numColors, mWorkspace.fill);
+    if (greedy < 0 || cancelled()) return;
+    publish(job, greedy, 1);
+
+    // Sau đó nhìn trước sâu dần, mỗi độ sâu hoàn tất sẽ thay kết quả trước
+    MoveSearch::IndexBoard board = MoveSearch::toIndexBoard(job.cells);
+    for (int depth = 2; depth <= MAX_HINT_DEPTH; ++depth) {
+        int best = MoveSearch::bestMove(board, topology, job.numColors, depth, cancelled, mWorkspace);
+        if (best < 0 || cancelled()) return;
+        publish(job, best, depth);
+    }
+}
+
+void HintWorker::publish(const Job& job, int colorIndex, int depth) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mGeneration.load() != job.generation) return;
+    mHasResult = true;
+    mResultRevision = job.revision;
+    mResultColor = PALETTE[colorIndex];
+    mResultDepth = depth;
+}
@@ -0,0 +1,74 @@
+﻿#pragma once
+
+#include "Constants.h"
+#include "MoveSearch.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class HintWorker
+ * @brief Tính sẵn gợi ý trên một luồng nền để nút Gợi ý phản hồi ngay.
+ *
+ * Mỗi yêu cầu gắn với số phiên bản (revision) của Grid. Yêu cầu mới hoặc cancel() tăng
+ * mGeneration, khiến tìm kiếm đang chạy tự dừng ở nút kế tiếp. Kết quả được làm tốt dần:
+ * đầu tiên là nước tham lam (1 bước), sau đó nhìn trước 2, 3, ... đến MAX_HINT_DEPTH bước.
+ */
+class HintWorker {
+public:
+    HintWorker();
+    ~HintWorker();
+
+    HintWorker(const HintWorker&) = delete;
+    HintWorker& operator=(const HintWorker&) = delete;
+
+    /**
+     * @brief Bắt đầu tính gợi ý cho lưới cells (hủy yêu cầu trước đó).
+     */
+    void request(const std::vector<std::vector<SDL_Color>>& cells, TopologyRef topology, int numColors, unsigned int revision);
+
+    /**
+     * @brief Hủy yêu cầu đang chạy (lưới sắp thay đổi).
+     */
+    void cancel();
+
+    /**
+     * @brief Lấy gợi ý tốt nhất hiện có cho đúng phiên bản revision.
+     * @param depth Nếu khác nullptr, nhận số bước nhìn trước của gợi ý.
+     * @return false nếu chưa có kết quả cho phiên bản này.
+     */
+    bool getHint(unsigned int revision, SDL_Color& color, int* depth = nullptr) const;
+
+    unsigned int getRequestedRevision() const { return mRequestedRevision; }
+
+private:
+    struct Job {
+        std::vector<std::vector<SDL_Color>> cells;
+        TopologyRef topology;
+        int numColors = 0;
+        unsigned int revision = 0;
+        unsigned int generation = 0;
+    };
+
+    void run();
+    void solve(const Job& job);
+    void publish(const Job& job, int colorIndex, int depth);
+
+    std::thread mThread;
+    mutable std::mutex mMutex;
+    std::condition_variable mCondition;
+    Job mPendingJob;
+    bool mHasJob;
+    bool mQuit;
+    std::atomic<unsigned int> mGeneration;
+    unsigned int mRequestedRevision; // Chỉ luồng chính dùng
+    MoveSearch::Workspace mWorkspace; // Chỉ luồng worker dùng, giữ lại giữa các lần tìm
+
+    // Kết quả (bảo vệ bởi mMutex)
+    bool mHasResult;
+    unsigned int mResultRevision;
+    SDL_Color mResultColor;
+    int mResultDepth;
+};
@@ -15,23 +15,23 @@ InstructionState::~InstructionState() {}
 
 void InstructionState::initPages() {
     // (Giữ nguyên danh sách 8 trang như cũ)
-    mPages.push_back({ "tut_p1_title", { "tut_p1_1", "tut_p1_2", "tut_p1_3" }, ILLUST_GOAL });
-    mPages.push_back({ "tut_p2_title", { "tut_p2_1", "tut_p2_2", "tut_p2_3" }, ILLUST_START });
-    mPages.push_back({ "tut_p3_title", { "tut_p3_1", "tut_p3_2", "tut_p3_3" }, ILLUST_MECHANICS });
-    mPages.push_back({ "tut_p4_title", { "tut_p4_1", "tut_p4_2", "tut_p4_3" }, ILLUST_STRATEGY });
-    mPages.push_back({ "tut_p5_title", { "tut_p5_1", "tut_p5_2", "tut_p5_3" }, ILLUST_MOVES });
-    mPages.push_back({ "tut_p6_title", { "tut_p6_1", "tut_p6_2", "tut_p6_3" }, ILLUST_FEATURES });
-    mPages.push_back({ "tut_p7_title", { "tut_p7_1", "tut_p7_2", "tut_p7_3" }, ILLUST_EVENT });
-    mPages.push_back({ "tut_p8_title", { "tut_p8_1", "tut_p8_2", "tut_p8_3" }, ILLUST_AI });
+    mPages.push_back({ TXT_TUT_P1_TITLE, { TXT_TUT_P1_1, TXT_TUT_P1_2, TXT_TUT_P1_3 }, ILLUST_GOAL });
+    mPages.push_back({ TXT_TUT_P2_TITLE, { TXT_TUT_P2_1, TXT_TUT_P2_2, TXT_TUT_P2_3 }, ILLUST_START });
+    mPages.push_back({ TXT_TUT_P3_TITLE, { TXT_TUT_P3_1, TXT_TUT_P3_2, TXT_TUT_P3_3 }, ILLUST_MECHANICS });
+    mPages.push_back({ TXT_TUT_P4_TITLE, { TXT_TUT_P4_1, TXT_TUT_P4_2, TXT_TUT_P4_3 }, ILLUST_STRATEGY });
+    mPages.push_back({ TXT_TUT_P5_TITLE, { TXT_TUT_P5_1, TXT_TUT_P5_2, TXT_TUT_P5_3 }, ILLUST_MOVES });
+    mPages.push_back({ TXT_TUT_P6_TITLE, { TXT_TUT_P6_1, TXT_TUT_P6_2, TXT_TUT_P6_3 }, ILLUST_FEATURES });
+    mPages.push_back({ TXT_TUT_P7_TITLE, { TXT_TUT_P7_1, TXT_TUT_P7_2, TXT_TUT_P7_3 }, ILLUST_EVENT });
+    mPages.push_back({ TXT_TUT_P8_TITLE, { TXT_TUT_P8_1, TXT_TUT_P8_2, TXT_TUT_P8_3 }, ILLUST_AI });
 }
 
 void InstructionState::initButtons() {
     int btnY = 640;
-    mUI.addButton("back", { SCREEN_WIDTH / 2 - 80, btnY, 160, 50 }, "settings_back", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("back", { SCREEN_WIDTH / 2 - 80, btnY, 160, 50 }, TXT_SETTINGS_BACK, BUTTON_GRAY, BUTTON_HIGHLIGHT);
 
     // Nút Prev/Next làm to hơn chút cho dễ bấm
-    mUI.addButton("prev", { 40, 300, 60, 100 }, "<", BUTTON_BLUE, BUTTON_HIGHLIGHT);
-    mUI.addButton("next", { SCREEN_WIDTH - 100, 300, 60, 100 }, ">", BUTTON_BLUE, BUTTON_HIGHLIGHT);
+    mUI.addButton("prev", { 40, 300, 60, 100 }, TXT_ARROW_PREV, BUTTON_BLUE, BUTTON_HIGHLIGHT);
+    mUI.addButton("next", { SCREEN_WIDTH - 100, 300, 60, 100 }, TXT_ARROW_NEXT, BUTTON_BLUE, BUTTON_HIGHLIGHT);
     mUI.updateButtonTexts();
 }
 
@@ -98,7 +98,7 @@ void InstructionState::draw(SDL_Renderer* renderer) {
     SDL_RenderDrawRect(renderer, &card);
 
     // 3. Tiêu đề
-    drawText(renderer, res->getText(currentPage.titleKey), SCREEN_WIDTH / 2, cardY + 40, res->getFontTitle(), PALETTE[2]);
+    drawText(renderer, res->getText(currentPage.titleId), SCREEN_WIDTH / 2, cardY + 40, res->getFontTitle(), PALETTE[2]);
 
     // 4. Khung Minh họa
     int illustW = 400;
@@ -127,8 +127,8 @@ void InstructionState::draw(SDL_Renderer* renderer) {
 
     // 5. Text nội dung
     int textY = cardY + 360;
-    for (const auto& lineKey : currentPage.contentKeys) {
-        drawText(renderer, res->getText(lineKey), SCREEN_WIDTH / 2, textY, res->getFontUI(), TEXT_WHITE);
+    for (TextId lineId : currentPage.contentIds) {
+        drawText(renderer, res->getText(lineId), SCREEN_WIDTH / 2, textY, res->getFontUI(), TEXT_WHITE);
         textY += 35;
     }
 
@@ -173,7 +173,7 @@ void InstructionState::drawIllustStart(SDL_Renderer* r, int x, int y, int w, int
     SDL_Rect start = { sx - 2, sy - 2, s + 4, s + 4 };
     SDL_SetRenderDrawColor(r, 255, 255, 0, 255);
     SDL_RenderDrawRect(r, &start);
-    drawText(r, mGame->getResources()->getText("illust_start"), sx + s * 2, sy - 30, mGame->getResources()->getFontSmall(), { 255, 255, 0, 255 });
+    drawText(r, mGame->getResources()->getText(TXT_ILLUST_START), sx + s * 2, sy - 30, mGame->getResources()->getFontSmall(), { 255, 255, 0, 255 });
 }
 
 void InstructionState::drawIllustMechanics(SDL_Renderer* r, int x, int y, int w, int h) {
@@ -186,7 +186,7 @@ void InstructionState::drawIllustMechanics(SDL_Renderer* r, int x, int y, int w,
         SDL_Rect cell = { sx + j * s, sy + i * s, s - 1, s - 1 };
         SDL_RenderFillRect(r, &cell);
     }
-    drawText(r, mGame->getResources()->getText("illust_click"), sx + s * 2, sy + s * 4 + 20, mGame->getResources()->getFontSmall(), TEXT_WHITE);
+    drawText(r, mGame->getResources()->getText(TXT_ILLUST_CLICK), sx + s * 2, sy + s * 4 + 20, mGame->getResources()->getFontSmall(), TEXT_WHITE);
 }
 
 void InstructionState::drawIllustStrategy(SDL_Renderer* r, int x, int y, int w, int h) {
@@ -202,11 +202,11 @@ void InstructionState::drawIllustStrategy(SDL_Renderer* r, int x, int y, int w,
     SDL_Rect r3 = { cx - s * 1.5, cy - s / 2, s, s }; SDL_RenderFillRect(r, &r3);
     SDL_SetRenderDrawColor(r, PALETTE[3].r, PALETTE[3].g, PALETTE[3].b, 255);
     SDL_Rect r4 = { cx - s / 2, cy + s / 2, s, s }; SDL_RenderFillRect(r, &r4);
-    drawText(r, mGame->getResources()->getText("illust_good"), cx, cy - s * 2, mGame->getResources()->getFontSmall(), PALETTE[1]);
+    drawText(r, mGame->getResources()->getText(TXT_ILLUST_GOOD), cx, cy - s * 2, mGame->getResources()->getFontSmall(), PALETTE[1]);
 }
 
 void InstructionState::drawIllustMoves(SDL_Renderer* r, int x, int y, int w, int h) {
-    std::string moveText = mGame->getResources()->getText("game_moves") + ": 5 / 20";
+    std::string moveText = std::string(mGame->getResources()->getText(TXT_GAME_MOVES)) + ": 5 / 20";
     drawText(r, moveText, x + w / 2, y + h / 2, mGame->getResources()->getFontTitle(), TEXT_WHITE);
     SDL_Rect barBg = { x + 50, y + h / 2 + 40, w - 100, 20 };
     SDL_SetRenderDrawColor(r, 100, 100, 100, 255);
@@ -223,12 +223,12 @@ void InstructionState::drawIllustFeatures(SDL_Renderer* r, int x, int y, int w,
     SDL_Rect undo = { startX, startY, btnW, btnH };
     SDL_SetRenderDrawColor(r, BUTTON_BLUE.r, BUTTON_BLUE.g, BUTTON_BLUE.b, 255);
     SDL_RenderFillRect(r, &undo);
-    drawText(r, mGame->getResources()->getText("game_undo"), startX + btnW / 2, startY + btnH / 2, mGame->getResources()->getFontSmall(), TEXT_BLACK);
+    drawText(r, mGame->getResources()->getText(TXT_GAME_UNDO), startX + btnW / 2, startY + btnH / 2, mGame->getResources()->getFontSmall(), TEXT_BLACK);
     startY += 60;
     SDL_Rect hint = { startX, startY, btnW, btnH };
     SDL_SetRenderDrawColor(r, BUTTON_YELLOW.r, BUTTON_YELLOW.g, BUTTON_YELLOW.b, 255);
     SDL_RenderFillRect(r, &hint);
-    drawText(r, mGame->getResources()->getText("game_hint"), startX + btnW / 2, startY + btnH / 2, mGame->getResources()->getFontSmall(), TEXT_BLACK);
+    drawText(r, mGame->getResources()->getText(TXT_GAME_HINT), startX + btnW / 2, startY + btnH / 2, mGame->getResources()->getFontSmall(), TEXT_BLACK);
 }
 
 void InstructionState::drawIllustEvent(SDL_Renderer* r, int x, int y, int w, int h) {
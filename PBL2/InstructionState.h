@@ -2,12 +2,13 @@
 #include "GameState.h"
 #include "UIManager.h"
 #include "Constants.h" 
+#include "TextId.h"
 #include <vector>
 #include <string>
 
 struct InstructionPage {
-    std::string titleKey;
-    std::vector<std::string> contentKeys;
+    TextId titleId;
+    std::vector<TextId> contentIds;
     IllustrationType illustType;
 };
 
@@ -19,6 +20,8 @@ public:
     virtual void handleEvents(SDL_Event& e) override;
     virtual void update() override;
     virtual void draw(SDL_Renderer* renderer) override;
+    virtual const char* getName() const override { return "InstructionState"; }
+    virtual UIManager* getUI() override { return &mUI; }
 
 private:
     void initButtons();
@@ -0,0 +1,40 @@
+﻿#include "LevelCalibrator.h"
+#include "MoveSearch.h"
+
+namespace {
+    // outOfBudget() được kiểm tra ở mỗi nút tìm kiếm của các lượt nhìn trước (không áp dụng cho lời giải tham lam)
+    template <typename Budget>
+    CalibrationResult calibrateWithin(const std::vector<std::vector<SDL_Color>>& cells, const Topology& topology, int numColors,
+        Budget& outOfBudget) {
+        CalibrationResult result;
+        if (cells.empty()) return result;
+
+        auto neverCancelled = [] { return false; };
+        MoveSearch::IndexBoard board = MoveSearch::toIndexBoard(cells);
+        MoveSearch::Workspace workspace; // Dùng chung cho mọi lần giải thử
+        const int moveCap = topology.getCellCount();
+
+        result.greedyMoves = MoveSearch::playout(board, topology, numColors, 1, moveCap, neverCancelled, workspace);
+        result.bestMoves = result.greedyMoves;
+        result.bestDepth = 1;
+
+        // Nhìn trước sâu dần; lời giải dài hơn lời giải hiện có thì không cần đi hết
+        for (int depth = 2; depth <= CALIBRATION_MAX_DEPTH && !outOfBudget(); ++depth) {
+            int moves = MoveSearch::playout(board, topology, numColors, depth, result.bestMoves - 1, outOfBudget, workspace);
+            if (moves > 0 && moves < result.bestMoves) {
+                result.bestMoves = moves;
+                result.bestDepth = depth;
+            }
+        }
+        return result;
+    }
+}
+
+CalibrationResult LevelCalibrator::calibrateNodes(const std::vector<std::vector<SDL_Color>>& cells, const Topology& topology, int numColors,
+    long long nodeBudget, const std::atomic<bool>* cancelled) {
+    long long nodes = 0;
+    auto outOfBudget = [&nodes, nodeBudget, cancelled] {
+        return ++nodes > nodeBudget || (cancelled && cancelled->load(std::memory_order_relaxed));
+    };
+    return calibrateWithin(cells, topology, numColors, outOfBudget);
+}
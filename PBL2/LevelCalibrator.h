@@ -0,0 +1,45 @@
+﻿#pragma once
+
+#include "Constants.h"
+#include "Topology.h"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/**
+ * @struct CalibrationResult
+ * @brief Kết quả giải thử một màn chơi để đặt giới hạn số bước.
+ */
+struct CalibrationResult {
+    int greedyMoves = -1; ///< Số bước của lời giải tham lam.
+    int bestMoves = -1;   ///< Số bước ngắn nhất tìm được trong ngân sách cho phép.
+    int bestDepth = 0;    ///< Số bước nhìn trước của lời giải ngắn nhất.
+};
+
+/**
+ * @class LevelCalibrator
+ * @brief Giải thử lưới vừa sinh (tham lam rồi nhìn trước có giới hạn) trong một ngân sách số nút tìm kiếm.
+ *
+ * Ngân sách tính theo nút chứ không theo thời gian, nên cùng lưới luôn cho cùng kết quả (và cùng giới hạn
+ * số bước) trên mọi máy, dù CPU đang bận hay dựng level pack với bao nhiêu luồng.
+ */
+class LevelCalibrator {
+public:
+    /**
+     * @brief Giải thử lưới. Lời giải tham lam luôn chạy xong; các lượt nhìn trước sâu hơn
+     *        chỉ được dùng nếu hoàn tất trong nodeBudget nút.
+     * @param cancelled Nếu khác null và được đặt true, dừng sớm (kết quả khi đó không dùng được).
+     */
+    static CalibrationResult calibrateNodes(const std::vector<std::vector<SDL_Color>>& cells, const Topology& topology, int numColors,
+        long long nodeBudget, const std::atomic<bool>* cancelled = nullptr);
+
+    /**
+     * @brief Số nút cho một ngân sách công việc (nút × số ô): mỗi nút tô lại cả lưới nên bàn lớn được ít nút hơn.
+     */
+    static long long nodeBudgetForWork(long long work, int cellCount) { return std::max(1LL, work / std::max(1, cellCount)); }
+
+    /**
+     * @brief Màn chơi đủ nhỏ để giải thử ngay trong một khung hình hay không.
+     */
+    static bool fitsInFrame(int gridDim) { return gridDim * gridDim <= CALIBRATION_SYNC_MAX_CELLS; }
+};
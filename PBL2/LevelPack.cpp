@@ -0,0 +1,218 @@
+﻿#include "LevelPack.h"
+#include "Game.h"
+#include "Grid.h"
+#include "LevelCalibrator.h"
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char PACK_MAGIC[8] = { 'P', 'B', 'L', '2', 'P', 'A', 'C', 'K' };
+    const uint32_t PACK_VERSION = 1;
+    const size_t HEADER_SIZE = 32;
+    const size_t RECORD_HEADER_SIZE = 16;
+    const int PACK_MIN_COLORS = 6;
+    const int PACK_COLOR_COUNT = 3; // 6, 7, 8 màu như trong Cài đặt
+    const int PACK_DIR_COUNT = 2;
+    // Giới hạn theo số nút tìm kiếm, không theo thời gian: pack dựng lại từ cùng seed phải giống hệt nhau trên mọi máy
+    const long long PACK_BUILD_NODE_BUDGET = 1000000;
+
+    uint32_t readU16(const unsigned char* p) { return p[0] | (p[1] << 8); }
+    uint32_t readU32(const unsigned char* p) { return readU16(p) | (readU16(p + 2) << 16); }
+    uint64_t readU64(const unsigned char* p) { return readU32(p) | ((uint64_t)readU32(p + 4) << 32); }
+
+    void writeU16(std::vector<unsigned char>& out, uint32_t v) { out.push_back(v & 0xFF); out.push_back((v >> 8) & 0xFF); }
+    void writeU32(std::vector<unsigned char>& out, uint32_t v) { writeU16(out, v & 0xFFFF); writeU16(out, v >> 16); }
+    void writeU64(std::vector<unsigned char>& out, uint64_t v) { writeU32(out, (uint32_t)v); writeU32(out, (uint32_t)(v >> 32)); }
+
+    size_t packedSize(int dim) { return ((size_t)dim * dim + 1) / 2; }
+}
+
+void LevelRecord::unpackCells(std::vector<std::vector<SDL_Color>>& cells) const {
+    cells.assign(dim, std::vector<SDL_Color>(dim));
+    for (int i = 0; i < dim * dim; ++i) {
+        int index = (packedCells[i / 2] >> ((i % 2) * 4)) & 0x0F;
+        cells[i % dim][i / dim] = PALETTE[index];
+    }
+}
+
+LevelPack::LevelPack()
+    : mData(nullptr), mSize(0), mLevelCount(0), mMinColors(0), mColorCount(0), mDirCount(0)
+#ifdef _WIN32
+    , mFileHandle(nullptr), mMappingHandle(nullptr)
+#else
+    , mFileDescriptor(-1)
+#endif
+{
+}
+
+LevelPack::~LevelPack() {
+    close();
+}
+
+bool LevelPack::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)HEADER_SIZE) { CloseHandle(file); return false; }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) { CloseHandle(file); return false; }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(mapping); CloseHandle(file); return false; }
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mData = static_cast<const unsigned char*>(view);
+    mSize = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)HEADER_SIZE) { ::close(fd); return false; }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) { ::close(fd); return false; }
+    mFileDescriptor = fd;
+    mData = static_cast<const unsigned char*>(view);
+    mSize = (size_t)st.st_size;
+#endif
+
+    if (std::memcmp(mData, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0 || readU32(mData + 8) != PACK_VERSION) {
+        std::cerr << "Level pack sai định dạng: " << path << std::endl;
+        close();
+        return false;
+    }
+    mLevelCount = (int)readU32(mData + 12);
+    mMinColors = (int)readU32(mData + 16);
+    mColorCount = (int)readU32(mData + 20);
+    mDirCount = (int)readU32(mData + 24);
+    size_t indexSize = (size_t)mLevelCount * mColorCount * mDirCount * 8;
+    if (mSize < HEADER_SIZE + indexSize) {
+        std::cerr << "Level pack bị cắt cụt: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void LevelPack::close() {
+    if (!mData) return;
+#ifdef _WIN32
+    UnmapViewOfFile(mData);
+    CloseHandle((HANDLE)mMappingHandle);
+    CloseHandle((HANDLE)mFileHandle);
+    mFileHandle = nullptr;
+    mMappingHandle = nullptr;
+#else
+    munmap(const_cast<unsigned char*>(mData), mSize);
+    ::close(mFileDescriptor);
+    mFileDescriptor = -1;
+#endif
+    mData = nullptr;
+    mSize = 0;
+}
+
+bool LevelPack::findLevel(int level, int numColors, FillDirection fillDir, LevelRecord& record) const {
+    if (!mData) return false;
+    int colorSlot = numColors - mMinColors;
+    int dirSlot = (int)fillDir;
+    if (level < 1 || level > mLevelCount || colorSlot < 0 || colorSlot >= mColorCount || dirSlot >= mDirCount) return false;
+
+    // Vị trí trong chỉ mục tính trực tiếp từ (màn, số màu, hướng tô)
+    size_t slot = ((size_t)(level - 1) * mColorCount + colorSlot) * mDirCount + dirSlot;
+    uint64_t offset = readU64(mData + HEADER_SIZE + slot * 8);
+    if (offset == 0 || offset + RECORD_HEADER_SIZE > mSize) return false;
+
+    const unsigned char* p = mData + offset;
+    record.seed = readU64(p);
+    record.dim = (int)readU16(p + 8);
+    record.numColors = p[10];
+    record.fillDir = (FillDirection)p[11];
+    record.greedyMoves = (int)readU16(p + 12);
+    record.bestMoves = (int)readU16(p + 14);
+    record.packedCells = p + RECORD_HEADER_SIZE;
+    if (record.dim <= 0 || offset + RECORD_HEADER_SIZE + packedSize(record.dim) > mSize) return false;
+    return record.numColors == numColors && record.fillDir == fillDir;
+}
+
+bool LevelPack::build(const std::string& path, int maxLevel, uint64_t baseSeed, int threadCount) {
+    const int slotCount = maxLevel * PACK_COLOR_COUNT * PACK_DIR_COUNT;
+    std::vector<std::vector<unsigned char>> records(slotCount);
+    std::atomic<int> nextSlot(0);
+
+    // Mỗi luồng lấy lần lượt các ô chỉ mục còn trống; seed chỉ phụ thuộc vào vị trí nên kết quả không đổi theo số luồng
+    auto worker = [&]() {
+        for (int slot = nextSlot++; slot < slotCount; slot = nextSlot++) {
+            int level = slot / (PACK_COLOR_COUNT * PACK_DIR_COUNT) + 1;
+            int numColors = PACK_MIN_COLORS + (slot / PACK_DIR_COUNT) % PACK_COLOR_COUNT;
+            FillDirection fillDir = (FillDirection)(slot % PACK_DIR_COUNT);
+            int dim = Game::getGridDimForLevel(level);
+            uint64_t seed = Random(baseSeed + (uint64_t)slot).nextU64();
+
+            TopologyRef topology = Topology::create(SHAPE_SQUARE, fillDir, dim);
+            Grid grid;
+            grid.init(numColors, ALGO_BFS, topology, seed);
+            const auto& cells = grid.getInitialCells();
+            CalibrationResult result = LevelCalibrator::calibrateNodes(cells, *topology, numColors, PACK_BUILD_NODE_BUDGET);
+
+            std::vector<unsigned char>& out = records[slot];
+            writeU64(out, seed);
+            writeU16(out, (uint32_t)dim);
+            out.push_back((unsigned char)numColors);
+            out.push_back((unsigned char)fillDir);
+            writeU16(out, (uint32_t)result.greedyMoves);
+            writeU16(out, (uint32_t)result.bestMoves);
+            std::vector<unsigned char> packed(packedSize(dim), 0);
+            for (int i = 0; i < dim * dim; ++i) {
+                int index = getPaletteIndex(cells[i % dim][i / dim]);
+                packed[i / 2] |= (unsigned char)((index & 0x0F) << ((i % 2) * 4));
+            }
+            out.insert(out.end(), packed.begin(), packed.end());
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < std::max(1, threadCount); ++i) threads.emplace_back(worker);
+    for (auto& t : threads) t.join();
+
+    std::vector<unsigned char> header;
+    header.insert(header.end(), PACK_MAGIC, PACK_MAGIC + sizeof(PACK_MAGIC));
+    writeU32(header, PACK_VERSION);
+    writeU32(header, (uint32_t)maxLevel);
+    writeU32(header, (uint32_t)PACK_MIN_COLORS);
+    writeU32(header, (uint32_t)PACK_COLOR_COUNT);
+    writeU32(header, (uint32_t)PACK_DIR_COUNT);
+    writeU32(header, 0);
+
+    uint64_t offset = HEADER_SIZE + (uint64_t)slotCount * 8;
+    for (const auto& record : records) {
+        writeU64(header, offset);
+        offset += record.size();
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Không thể ghi level pack: " << path << std::endl;
+        return false;
+    }
+    file.write((const char*)header.data(), (std::streamsize)header.size());
+    for (const auto& record : records) {
+        file.write((const char*)record.data(), (std::streamsize)record.size());
+    }
+    std::cout << "Đã ghi " << slotCount << " màn vào " << path << std::endl;
+    return file.good();
+}
@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "Constants.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct LevelRecord
+ * @brief Một màn chơi đọc trực tiếp từ vùng nhớ đã map của file level pack.
+ */
+struct LevelRecord {
+    uint64_t seed = 0;                 ///< Seed của màn (dùng cho sự kiện đổi màu).
+    int dim = 0;                       ///< Số ô mỗi cạnh.
+    int numColors = 0;                 ///< Số màu.
+    FillDirection fillDir = DIR_FOUR;  ///< Hướng tô.
+    int greedyMoves = 0;               ///< Số bước của lời giải tham lam.
+    int bestMoves = 0;                 ///< Số bước ngắn nhất đã biết.
+    const unsigned char* packedCells = nullptr; ///< Chỉ số màu, 2 ô mỗi byte (nibble thấp trước), thứ tự y * dim + x.
+
+    /**
+     * @brief Giải nén lưới màu theo dạng cells[x][y] của Grid.
+     */
+    void unpackCells(std::vector<std::vector<SDL_Color>>& cells) const;
+};
+
+/**
+ * @class LevelPack
+ * @brief File chứa các màn chơi sinh sẵn, đã được giải thử và kiểm tra.
+ *
+ * Bố cục file (little-endian):
+ * - Header 32 byte: magic "PBL2PACK", version, số màn, số màu nhỏ nhất, số biến thể màu, số hướng tô, dự phòng.
+ * - Bảng chỉ mục: một offset u64 cho mỗi (màn, số màu, hướng tô); 0 nghĩa là không có.
+ * - Các bản ghi: seed u64, dim u16, số màu u8, hướng tô u8, greedy u16, best u16, rồi các ô đã nén.
+ *
+ * File được map vào bộ nhớ (mmap / CreateFileMapping) nên mở màn chơi là O(1), không cần đọc hay sinh lại.
+ * Pack chỉ chứa bàn cờ ô vuông (SHAPE_SQUARE); các dạng bàn cờ khác luôn sinh map lúc chơi.
+ */
+class LevelPack {
+public:
+    LevelPack();
+    ~LevelPack();
+
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    /**
+     * @brief Map file level pack vào bộ nhớ.
+     * @return false nếu file không tồn tại hoặc sai định dạng.
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mData != nullptr; }
+
+    /**
+     * @brief Tra cứu màn chơi trong chỉ mục.
+     * @return false nếu pack không có màn này.
+     */
+    bool findLevel(int level, int numColors, FillDirection fillDir, LevelRecord& record) const;
+
+    /**
+     * @brief Sinh một level pack cho các màn 1..maxLevel, mọi số màu và hướng tô, song song trên threadCount luồng.
+     */
+    static bool build(const std::string& path, int maxLevel, uint64_t baseSeed, int threadCount);
+
+private:
+    const unsigned char* mData;
+    size_t mSize;
+    int mLevelCount, mMinColors, mColorCount, mDirCount;
+
+#ifdef _WIN32
+    void* mFileHandle;
+    void* mMappingHandle;
+#else
+    int mFileDescriptor;
+#endif
+};
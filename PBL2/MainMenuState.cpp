@@ -9,7 +9,6 @@
 #include <iostream>
 #include <limits> 
 #include <SDL_mixer.h> 
-#include <cstdlib> // Cho rand()
 
 MainMenuState::MainMenuState(Game* game) : GameState(game) {
     mUI.init(mGame->getResources());
@@ -33,77 +32,55 @@ void MainMenuState::initButtons() {
     int total_menu_height = 5 * btnH + 4 * pad;
     int startY = 140 + (SCREEN_HEIGHT - 140 - total_menu_height) / 2;
 
-    mUI.addButton("main_continue", { startX, startY, btnW, btnH }, "main_continue", BUTTON_GREEN, BUTTON_HIGHLIGHT);
-    mUI.addButton("main_new_game", { startX, startY + (btnH + pad), btnW, btnH }, "main_new_game", BUTTON_BLUE, BUTTON_HIGHLIGHT);
-    mUI.addButton("main_ai_solver", { startX, startY + 2 * (btnH + pad), btnW, btnH }, "main_ai_solver", BUTTON_YELLOW, BUTTON_HIGHLIGHT);
-    mUI.addButton("main_settings", { startX, startY + 3 * (btnH + pad), btnW, btnH }, "main_settings", PALETTE[5], BUTTON_HIGHLIGHT);
-    mUI.addButton("main_exit", { startX, startY + 4 * (btnH + pad), btnW, btnH }, "main_exit", BUTTON_RED, BUTTON_HIGHLIGHT);
+    mUI.addButton("main_continue", { startX, startY, btnW, btnH }, TXT_MAIN_CONTINUE, BUTTON_GREEN, BUTTON_HIGHLIGHT);
+    mUI.addButton("main_new_game", { startX, startY + (btnH + pad), btnW, btnH }, TXT_MAIN_NEW_GAME, BUTTON_BLUE, BUTTON_HIGHLIGHT);
+    mUI.addButton("main_ai_solver", { startX, startY + 2 * (btnH + pad), btnW, btnH }, TXT_MAIN_AI_SOLVER, BUTTON_YELLOW, BUTTON_HIGHLIGHT);
+    mUI.addButton("main_settings", { startX, startY + 3 * (btnH + pad), btnW, btnH }, TXT_MAIN_SETTINGS, PALETTE[5], BUTTON_HIGHLIGHT);
+    mUI.addButton("main_exit", { startX, startY + 4 * (btnH + pad), btnW, btnH }, TXT_MAIN_EXIT, BUTTON_RED, BUTTON_HIGHLIGHT);
 
     int smallBtnW = 150, smallBtnH = 50, smallPad = 10;
     int smallStartX = SCREEN_WIDTH - smallBtnW - smallPad;
 
-    mUI.addButton("instructions", { smallStartX, smallPad, smallBtnW, smallBtnH }, "main_instructions", BUTTON_BLUE, BUTTON_HIGHLIGHT);
-    mUI.addButton("credits", { smallStartX, smallPad + smallBtnH + smallPad, smallBtnW, smallBtnH }, "main_credits", BUTTON_YELLOW, BUTTON_HIGHLIGHT);
+    mUI.addButton("instructions", { smallStartX, smallPad, smallBtnW, smallBtnH }, TXT_MAIN_INSTRUCTIONS, BUTTON_BLUE, BUTTON_HIGHLIGHT);
+    mUI.addButton("credits", { smallStartX, smallPad + smallBtnH + smallPad, smallBtnW, smallBtnH }, TXT_MAIN_CREDITS, BUTTON_YELLOW, BUTTON_HIGHLIGHT);
 
     mUI.updateButtonTexts();
 }
 
 // === 2. LOGIC NỀN (PARTICLES) ===
 void MainMenuState::initParticles() {
-    for (int i = 0; i < 50; ++i) {
-        FloatingBlock b;
-        b.x = (float)(rand() % SCREEN_WIDTH);
-        b.y = (float)(rand() % SCREEN_HEIGHT);
-        b.size = 20 + rand() % 40;
-        b.speed = 0.5f + (rand() % 100) / 100.0f;
-        b.color = PALETTE[rand() % PALETTE.size()];
-        b.alpha = 50 + rand() % 100;
-        mParticles.push_back(b);
-    }
-}
-
-void MainMenuState::updateParticles() {
-    for (auto& b : mParticles) {
-        b.y -= b.speed;
-        if (b.y + b.size < 0) {
-            b.y = (float)SCREEN_HEIGHT;
-            b.x = (float)(rand() % SCREEN_WIDTH);
-            b.color = PALETTE[rand() % PALETTE.size()];
-        }
-    }
-}
-
-void MainMenuState::drawParticles(SDL_Renderer* renderer) {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    for (const auto& b : mParticles) {
-        SDL_SetRenderDrawColor(renderer, b.color.r, b.color.g, b.color.b, b.alpha);
-        SDL_Rect r = { (int)b.x, (int)b.y, b.size, b.size };
-        SDL_RenderFillRect(renderer, &r);
-    }
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    ParticleConfig config;
+    config.area = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+    config.minSpeed = 0.5f; config.speedRange = 1.0f;
+    config.minWidth = 20; config.widthRange = 40;
+    config.square = true;
+    config.minAlpha = 50; config.alphaRange = 100;
+    config.colors = PALETTE;
+    mParticles.init(config, 50, mGame->getEffectsRandom().nextU64());
 }
 
 // === 3. LOGIC UPDATE CHÍNH ===
 void MainMenuState::update() {
-    updateParticles(); // Cập nhật nền
+    mParticles.update(); // Cập nhật nền
 
     // CẬP NHẬT GLITCH
+    Random& rng = mGame->getEffectsRandom();
     if (mIsGlitching) {
         mGlitchTimer--;
         // Rung lắc ngẫu nhiên
-        mGlitchOffsetX = (rand() % 10) - 5;
-        mGlitchOffsetY = (rand() % 6) - 3;
+        mGlitchOffsetX = rng.nextInt(10) - 5;
+        mGlitchOffsetY = rng.nextInt(6) - 3;
 
         if (mGlitchTimer <= 0) {
             mIsGlitching = false; // Kết thúc nhiễu
-            mGlitchTimer = rand() % 100 + 50; // Chờ một lúc
+            mGlitchTimer = rng.nextInt(100) + 50; // Chờ một lúc
         }
     }
     else {
         mGlitchTimer--;
         if (mGlitchTimer <= 0) {
             mIsGlitching = true; // Bắt đầu nhiễu
-            mGlitchTimer = rand() % 10 + 5;
+            mGlitchTimer = rng.nextInt(10) + 5;
         }
     }
 }
@@ -112,7 +89,7 @@ void MainMenuState::update() {
 void MainMenuState::drawGlitchTitle(SDL_Renderer* renderer) {
     auto res = mGame->getResources();
     TTF_Font* font = res->getFontTitle();
-    std::string text = res->getText("main_title");
+    std::string text(res->getText(TXT_MAIN_TITLE));
 
     int centerX = SCREEN_WIDTH / 2;
     int centerY = 120;
@@ -128,8 +105,9 @@ void MainMenuState::drawGlitchTitle(SDL_Renderer* renderer) {
         // Kẻ vài đường ngang (Scanlines)
         SDL_SetRenderDrawColor(renderer, 30, 30, 30, 200);
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        Random& rng = mGame->getEffectsRandom();
         for (int i = 0; i < 3; ++i) {
-            int ly = centerY - 30 + rand() % 60;
+            int ly = centerY - 30 + rng.nextInt(60);
             SDL_RenderDrawLine(renderer, centerX - 200, ly, centerX + 200, ly);
         }
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
@@ -152,7 +130,7 @@ void MainMenuState::draw(SDL_Renderer* renderer) {
     SDL_RenderClear(renderer);
 
     // 1. Vẽ nền (ô vuông bay)
-    drawParticles(renderer);
+    mParticles.draw(renderer);
 
     // 2. Vẽ tiêu đề Glitch
     drawGlitchTitle(renderer);
@@ -242,7 +220,29 @@ void MainMenuState::loadAndPushPlayingState(bool isContinue) {
         std::vector<std::vector<SDL_Color>> initialGrid(gridDim, std::vector<SDL_Color>(gridDim));
         std::vector<std::vector<SDL_Color>> currentGrid(gridDim, std::vector<SDL_Color>(gridDim));
 
+        // Dòng Shape: (và Mask: với bàn có lỗ) có từ khi thêm các dạng bàn cờ; file cũ là ô vuông
+        int shape = SHAPE_SQUARE;
+        std::vector<unsigned char> mask;
         saveFile >> label;
+        if (label == "Shape:") {
+            saveFile >> shape >> label;
+            if (shape < SHAPE_SQUARE || shape > SHAPE_MASKED) {
+                saveFile.close(); mGame->deleteSaveFile(); mGame->setSaveFileExists(false); return;
+            }
+        }
+        if (shape == SHAPE_MASKED) {
+            if (label != "Mask:") {
+                saveFile.close(); mGame->deleteSaveFile(); mGame->setSaveFileExists(false); return;
+            }
+            mask.assign((size_t)gridDim * gridDim, 0);
+            for (int y = 0; y < gridDim; ++y) {
+                for (int x = 0; x < gridDim; ++x) {
+                    int active; saveFile >> active;
+                    mask[x * gridDim + y] = active ? 1 : 0;
+                }
+            }
+            saveFile >> label;
+        }
         if (label != "InitialGrid:") {
             saveFile.close(); mGame->deleteSaveFile(); mGame->setSaveFileExists(false); return;
         }
@@ -264,17 +264,19 @@ void MainMenuState::loadAndPushPlayingState(bool isContinue) {
         }
         saveFile.close();
 
+        TopologyRef topology = (shape == SHAPE_MASKED)
+            ? Topology::createMasked(mGame->getFillDirection(), gridDim, std::move(mask))
+            : Topology::create((BoardShape)shape, mGame->getFillDirection(), gridDim);
         mGame->pushState(new PlayingState(mGame, mGame->getResources(), level, gridDim, numColors, maxMoves,
-            mGame->getAlgorithm(), mGame->getFillDirection(), moves, savedTime, initialGrid, currentGrid));
+            mGame->getAlgorithm(), topology, moves, savedTime, std::move(initialGrid), std::move(currentGrid)));
     }
     else {
         int level = mGame->getHighestLevel();
-        int gridDim = 6 + (level - 1) * 2; gridDim = std::min(gridDim, 40);
+        int gridDim = Game::getGridDimForLevel(level);
         int numColors = mGame->getNumColors();
-        float modifier = mGame->getDifficultyModifier();
-        int maxMoves = static_cast<int>((gridDim * gridDim * numColors) / (gridDim * modifier) + 5);
+        int maxMoves = mGame->getFormulaMaxMoves(gridDim, numColors);
 
         mGame->pushState(new PlayingState(mGame, mGame->getResources(), level, gridDim, numColors, maxMoves,
-            mGame->getAlgorithm(), mGame->getFillDirection()));
+            mGame->getAlgorithm(), mGame->getFillDirection(), mGame->getBoardShape()));
     }
 }
\ No newline at end of file
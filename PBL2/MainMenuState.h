@@ -2,17 +2,9 @@
 #include "GameState.h"
 #include "UIManager.h"
 #include "Constants.h"
+#include "ParticleSystem.h"
 #include <vector>
 
-// Cấu trúc cho các ô vuông bay ở nền
-struct FloatingBlock {
-    float x, y;
-    float speed;
-    int size;
-    SDL_Color color;
-    int alpha;
-};
-
 class MainMenuState : public GameState {
 public:
     MainMenuState(Game* game);
@@ -21,6 +13,8 @@ public:
     virtual void handleEvents(SDL_Event& e) override;
     virtual void update() override;
     virtual void draw(SDL_Renderer* renderer) override;
+    virtual const char* getName() const override { return "MainMenuState"; }
+    virtual UIManager* getUI() override { return &mUI; }
 
 private:
     void initButtons();
@@ -28,14 +22,12 @@ private:
 
     // === HÀM TRANG TRÍ ===
     void initParticles();
-    void updateParticles();
-    void drawParticles(SDL_Renderer* renderer);
 
     // Hàm vẽ tiêu đề hiệu ứng Glitch
     void drawGlitchTitle(SDL_Renderer* renderer);
 
     UIManager mUI;
-    std::vector<FloatingBlock> mParticles;
+    ParticleSystem mParticles; ///< Các ô vuông bay ở nền
 
     // === BIẾN CHO HIỆU ỨNG GLITCH ===
     int mGlitchTimer;
@@ -0,0 +1,61 @@
+﻿#include "MemoryStats.h"
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    std::atomic<long long> gCurrent[MEM_TAG_COUNT];
+    std::atomic<long long> gPeak[MEM_TAG_COUNT];
+
+    const char* TAG_NAMES[MEM_TAG_COUNT] = {
+        "Grid", "AI solvers", "Undo history", "Fill containers", "Textures", "Sounds"
+    };
+}
+
+namespace MemoryStats {
+    void add(MemoryTag tag, long long bytes) {
+        long long now = gCurrent[tag].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        long long peak = gPeak[tag].load(std::memory_order_relaxed);
+        while (now > peak && !gPeak[tag].compare_exchange_weak(peak, now, std::memory_order_relaxed)) {}
+    }
+
+    long long getCurrent(MemoryTag tag) {
+        return gCurrent[tag].load(std::memory_order_relaxed);
+    }
+
+    long long getPeak(MemoryTag tag) {
+        return gPeak[tag].load(std::memory_order_relaxed);
+    }
+
+    const char* getTagName(MemoryTag tag) {
+        return TAG_NAMES[tag];
+    }
+
+    void resetPeaks() {
+        for (int i = 0; i < MEM_TAG_COUNT; ++i) {
+            gPeak[i].store(gCurrent[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<std::string> formatLines() {
+        std::vector<std::string> lines;
+        long long totalCurrent = 0, totalPeak = 0;
+        for (int i = 0; i < MEM_TAG_COUNT; ++i) {
+            MemoryTag tag = (MemoryTag)i;
+            totalCurrent += getCurrent(tag);
+            totalPeak += getPeak(tag);
+            lines.push_back(std::string(getTagName(tag)) + ": " + formatBytes(getCurrent(tag)) + " / " + formatBytes(getPeak(tag)));
+        }
+        // Tổng các đỉnh là cận trên: các nhóm không nhất thiết đạt đỉnh cùng lúc
+        lines.push_back("Total: " + formatBytes(totalCurrent) + " / <= " + formatBytes(totalPeak));
+        return lines;
+    }
+
+    std::string formatBytes(long long bytes) {
+        std::ostringstream out;
+        if (bytes < 1024) out << bytes << " B";
+        else if (bytes < 1024 * 1024) out << std::fixed << std::setprecision(1) << bytes / 1024.0 << " KB";
+        else out << std::fixed << std::setprecision(2) << bytes / (1024.0 * 1024.0) << " MB";
+        return out.str();
+    }
+}
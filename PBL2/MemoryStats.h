@@ -0,0 +1,93 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @file MemoryStats.h
+ * @brief Đếm số byte đang dùng và đỉnh cao nhất theo từng nhóm (lưới, lịch sử hoàn tác, AI...).
+ *
+ * Chỉ đếm phần dữ liệu chính của mỗi nhóm (ô lưới, container tô màu, texture, âm thanh), không
+ * thay operator new toàn cục. Bộ đếm là nguyên tử nên các luồng AI/tải tài nguyên cập nhật được.
+ */
+enum MemoryTag {
+    MEM_GRID,            ///< mCells của lưới người chơi và các lưới ban đầu dùng chung (BoardSnapshot)
+    MEM_SOLVER_GRIDS,    ///< Lưới riêng và ảnh chụp của các AISolver
+    MEM_UNDO_HISTORY,    ///< Lịch sử hoàn tác của PlayingState
+    MEM_FILL_CONTAINERS, ///< Hàng đợi BFS / ngăn xếp DFS của thuật toán tô màu
+    MEM_TEXTURES,        ///< Texture chữ (tạm thời, chỉ hiện ở đỉnh) và lớp hình vẽ sẵn (ước tính 4 byte mỗi điểm ảnh)
+    MEM_SOUNDS,          ///< Dữ liệu âm thanh đã giải mã
+    MEM_TAG_COUNT
+};
+
+namespace MemoryStats {
+    void add(MemoryTag tag, long long bytes);
+    long long getCurrent(MemoryTag tag);
+    long long getPeak(MemoryTag tag);
+    const char* getTagName(MemoryTag tag);
+
+    /**
+     * @brief Đặt đỉnh của mọi nhóm về mức hiện tại (bắt đầu một lần đo mới).
+     */
+    void resetPeaks();
+
+    /**
+     * @brief Mỗi nhóm một dòng "tên: hiện tại / đỉnh" (dùng cho overlay và báo cáo).
+     */
+    std::vector<std::string> formatLines();
+
+    std::string formatBytes(long long bytes);
+}
+
+/**
+ * @brief Số byte dữ liệu (theo capacity) của một mảng hai chiều dạng vector lồng nhau.
+ */
+template <typename T>
+size_t nestedVectorBytes(const std::vector<std::vector<T>>& v) {
+    size_t bytes = v.capacity() * sizeof(std::vector<T>);
+    for (const auto& row : v) bytes += row.capacity() * sizeof(T);
+    return bytes;
+}
+
+/**
+ * @class MemoryCharge
+ * @brief Khoản bộ nhớ một đối tượng đang giữ, tự cộng/trừ vào MemoryStats theo vòng đời đối tượng.
+ *
+ * Gắn làm thành viên cạnh dữ liệu cần đếm và gọi set() mỗi khi kích thước thay đổi. Khi sao chép
+ * đối tượng chủ, khoản này cũng được cộng thêm một lần; khi hủy thì được trừ đi.
+ */
+class MemoryCharge {
+public:
+    explicit MemoryCharge(MemoryTag tag) : mTag(tag), mBytes(0) {}
+    MemoryCharge(const MemoryCharge& other) : mTag(other.mTag), mBytes(0) { set(other.mBytes); }
+    MemoryCharge& operator=(const MemoryCharge& other) {
+        // Giữ nhóm của đối tượng đích, chỉ nhận kích thước
+        set(other.mBytes);
+        return *this;
+    }
+    ~MemoryCharge() { set(0); }
+
+    void set(size_t bytes) {
+        if (bytes == mBytes) return;
+        MemoryStats::add(mTag, (long long)bytes - (long long)mBytes);
+        mBytes = bytes;
+    }
+
+    /**
+     * @brief Chuyển khoản đang giữ sang nhóm khác (vd. Grid của AISolver tính vào MEM_SOLVER_GRIDS).
+     */
+    void setTag(MemoryTag tag) {
+        if (tag == mTag) return;
+        size_t bytes = mBytes;
+        set(0);
+        mTag = tag;
+        set(bytes);
+    }
+
+    size_t getBytes() const { return mBytes; }
+
+private:
+    MemoryTag mTag;
+    size_t mBytes;
+};
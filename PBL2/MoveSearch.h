@@ -0,0 +1,124 @@
+﻿#pragma once
+
+#include "FloodFill.h"
+
+/**
+ * @file MoveSearch.h
+ * @brief Tìm nước đi nhìn trước nhiều bước cho gợi ý.
+ *
+ * Tìm kiếm chạy trên lưới chỉ số màu (1 byte mỗi ô) thay vì SDL_Color để sao chép
+ * lưới ở mỗi nút rẻ hơn. Giá trị của một nhánh là kích thước vùng (0,0) lớn nhất
+ * đạt được sau depth nước; thắng sớm hơn được cộng thêm số nước còn dư.
+ * Mọi hàm nhận topology của bàn cờ; thắng là khi vùng phủ hết topo.getCellCount() ô.
+ */
+namespace MoveSearch {
+
+typedef FloodFill::Board<unsigned char> IndexBoard;
+
+/**
+ * @brief Chuyển lưới màu sang lưới chỉ số trong PALETTE.
+ */
+inline IndexBoard toIndexBoard(const FloodFill::Board<SDL_Color>& cells) {
+    IndexBoard board(cells.size(), std::vector<unsigned char>(cells.size()));
+    for (size_t x = 0; x < cells.size(); ++x) {
+        for (size_t y = 0; y < cells[x].size(); ++y) {
+            int index = getPaletteIndex(cells[x][y]);
+            board[x][y] = (unsigned char)(index >= 0 ? index : 0);
+        }
+    }
+    return board;
+}
+
+/**
+ * @struct Workspace
+ * @brief Bộ nhớ tạm của một luồng tìm kiếm: Scratch cho BFS và một lưới đệm cho mỗi tầng độ sâu.
+ *
+ * Giữ Workspace lại giữa các lần gọi (HintWorker giữ một cái cho luồng của nó) thì sau lần tìm
+ * đầu tiên, các nút tìm kiếm chỉ sao chép vào lưới đệm sẵn có chứ không cấp phát.
+ */
+struct Workspace {
+    FloodFill::Scratch fill;
+    std::vector<IndexBoard> boards; ///< boards[d] là lưới con của nút còn d nước.
+};
+
+/**
+ * @brief Tô vùng (0,0) bằng màu color.
+ * @return Kích thước vùng (0,0) sau khi tô.
+ */
+inline int applyMove(IndexBoard& board, const Topology& topo, unsigned char color, FloodFill::Scratch& scratch) {
+    FloodFill::regionFromOrigin(board, topo, scratch);
+    for (const FloodFill::CellPos& p : scratch.work) {
+        board[p.first][p.second] = color;
+    }
+    return FloodFill::regionFromOrigin(board, topo, scratch);
+}
+
+/**
+ * @brief Giá trị tốt nhất đạt được từ board trong depth nước. cancelled() được kiểm tra ở mỗi nút.
+ */
+template <typename Cancel>
+int searchValue(const IndexBoard& board, const Topology& topo, int regionSize, int numColors, int depth, Cancel& cancelled, Workspace& ws) {
+    const int total = topo.getCellCount();
+    if (regionSize == total) return total + depth;
+    if (depth == 0 || cancelled()) return regionSize;
+
+    IndexBoard& next = ws.boards[depth];
+    int best = regionSize;
+    for (int c = 0; c < numColors; ++c) {
+        if (c == board[0][0]) continue;
+        next = board;
+        int nextSize = applyMove(next, topo, (unsigned char)c, ws.fill);
+        if (nextSize == regionSize) continue; // Nước không nối thêm ô nào
+        best = std::max(best, searchValue(next, topo, nextSize, numColors, depth - 1, cancelled, ws));
+    }
+    return best;
+}
+
+/**
+ * @brief Nước đi đầu tiên tốt nhất khi nhìn trước depth nước (depth = 1 trùng với FloodFill::bestMove).
+ * @return Chỉ số màu trong palette, hoặc -1 nếu bị hủy hoặc không có nước nào.
+ */
+template <typename Cancel>
+int bestMove(const IndexBoard& board, const Topology& topo, int numColors, int depth, Cancel& cancelled, Workspace& ws) {
+    if (board.empty()) return -1;
+    // Cấp đủ lưới đệm trước khi đệ quy, để tham chiếu tới từng tầng không bị vô hiệu
+    if ((int)ws.boards.size() <= depth) ws.boards.resize(depth + 1);
+
+    IndexBoard& next = ws.boards[depth];
+    int bestIndex = -1;
+    int bestValue = -1;
+    for (int c = 0; c < numColors; ++c) {
+        if (c == board[0][0]) continue;
+        next = board;
+        int nextSize = applyMove(next, topo, (unsigned char)c, ws.fill);
+        int value = searchValue(next, topo, nextSize, numColors, depth - 1, cancelled, ws);
+        if (cancelled()) return -1;
+        if (value > bestValue) {
+            bestValue = value;
+            bestIndex = c;
+        }
+    }
+    return bestIndex;
+}
+
+/**
+ * @brief Giải hết lưới bằng cách lặp bestMove với depth bước nhìn trước (depth = 1 là tham lam).
+ * @return Số nước đã dùng, hoặc -1 nếu bị hủy hoặc vượt quá maxMoves.
+ */
+template <typename Cancel>
+int playout(IndexBoard board, const Topology& topo, int numColors, int depth, int maxMoves, Cancel& cancelled, Workspace& ws) {
+    if (board.empty()) return 0;
+    const int total = topo.getCellCount();
+    int regionSize = FloodFill::regionFromOrigin(board, topo, ws.fill);
+    int moves = 0;
+    while (regionSize < total) {
+        if (moves >= maxMoves) return -1;
+        int move = bestMove(board, topo, numColors, depth, cancelled, ws);
+        if (move < 0) return -1;
+        regionSize = applyMove(board, topo, (unsigned char)move, ws.fill);
+        moves++;
+    }
+    return moves;
+}
+
+} // namespace MoveSearch
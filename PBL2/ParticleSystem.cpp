@@ -0,0 +1,85 @@
+﻿#include "ParticleSystem.h"
+
+void ParticleSystem::init(const ParticleConfig& config, int count, uint64_t seed) {
+    mConfig = config;
+    mRng.setSeed(seed);
+
+    mX.assign(count, 0.0f);
+    mY.assign(count, 0.0f);
+    mVelocity.assign(count, 0.0f);
+    mWidth.assign(count, 0.0f);
+    mHeight.assign(count, 0.0f);
+    mColor.assign(count, SDL_Color{ 0, 0, 0, 0 });
+
+    mVertices.assign((size_t)count * 4, SDL_Vertex{});
+    mIndices.resize((size_t)count * 6);
+    for (int i = 0; i < count; ++i) {
+        int v = i * 4;
+        int* idx = &mIndices[(size_t)i * 6];
+        idx[0] = v; idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v + 2; idx[4] = v + 3; idx[5] = v;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        spawn(i, true);
+    }
+}
+
+void ParticleSystem::spawn(int i, bool anywhere) {
+    const ParticleConfig& c = mConfig;
+    mWidth[i] = (float)(c.minWidth + mRng.nextInt(c.widthRange));
+    mHeight[i] = c.square ? mWidth[i] : (float)(c.minHeight + mRng.nextInt(c.heightRange));
+
+    float speed = c.minSpeed + mRng.nextFloat() * c.speedRange;
+    mVelocity[i] = c.fallDown ? speed : -speed;
+
+    mX[i] = (float)(c.area.x + mRng.nextInt(c.area.w));
+    if (anywhere) {
+        mY[i] = (float)(c.area.y + mRng.nextInt(c.area.h));
+    }
+    else {
+        mY[i] = c.fallDown ? (float)c.area.y - mHeight[i] : (float)(c.area.y + c.area.h);
+    }
+
+    SDL_Color color = c.colors.empty() ? SDL_Color{ 255, 255, 255, 255 } : c.colors[mRng.nextInt((int)c.colors.size())];
+    color.a = (Uint8)(c.minAlpha + mRng.nextInt(c.alphaRange));
+    mColor[i] = color;
+}
+
+void ParticleSystem::update() {
+    const int n = size();
+    float* y = mY.data();
+    const float* v = mVelocity.data();
+    for (int i = 0; i < n; ++i) {
+        y[i] += v[i];
+    }
+
+    const float top = (float)mConfig.area.y;
+    const float bottom = (float)(mConfig.area.y + mConfig.area.h);
+    for (int i = 0; i < n; ++i) {
+        bool out = mConfig.fallDown ? (y[i] > bottom) : (y[i] + mHeight[i] < top);
+        if (out) spawn(i, false);
+    }
+}
+
+void ParticleSystem::draw(SDL_Renderer* renderer) {
+    const int n = size();
+    if (n == 0) return;
+
+    SDL_Vertex* vert = mVertices.data();
+    for (int i = 0; i < n; ++i) {
+        float x0 = mX[i], y0 = mY[i];
+        float x1 = x0 + mWidth[i], y1 = y0 + mHeight[i];
+        SDL_Color c = mColor[i];
+        vert[0].position = { x0, y0 }; vert[0].color = c;
+        vert[1].position = { x1, y0 }; vert[1].color = c;
+        vert[2].position = { x1, y1 }; vert[2].color = c;
+        vert[3].position = { x0, y1 }; vert[3].color = c;
+        vert += 4;
+    }
+
+    // Geometry không có texture dùng blend mode vẽ hiện tại của renderer
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_RenderGeometry(renderer, nullptr, mVertices.data(), n * 4, mIndices.data(), n * 6);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
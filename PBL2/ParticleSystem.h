@@ -0,0 +1,58 @@
+﻿#pragma once
+
+#include <SDL.h>
+#include "Random.h"
+#include <vector>
+
+/**
+ * @brief Cấu hình một hệ hạt: vùng bay, hướng bay và khoảng ngẫu nhiên của từng thuộc tính.
+ */
+struct ParticleConfig {
+    SDL_Rect area = { 0, 0, 0, 0 }; ///< Hạt sinh và bay trong vùng này, ra khỏi vùng thì sinh lại ở mép đối diện.
+    bool fallDown = false;          ///< true: rơi xuống (mưa), false: bay lên.
+    float minSpeed = 0.0f, speedRange = 0.0f; ///< Điểm ảnh mỗi khung hình.
+    int minWidth = 0, widthRange = 0;
+    int minHeight = 0, heightRange = 0;
+    bool square = false;            ///< Bỏ qua chiều cao, hạt là hình vuông cạnh = chiều rộng.
+    int minAlpha = 0, alphaRange = 0;
+    std::vector<SDL_Color> colors;
+};
+
+/**
+ * @class ParticleSystem
+ * @brief Hệ hạt trang trí dùng chung cho menu, màn chơi và credits.
+ *
+ * Thuộc tính hạt lưu theo dạng structure-of-arrays: vòng cập nhật vị trí chỉ chạy trên các mảng
+ * float liền nhau nên trình biên dịch vector hóa được, việc sinh lại hạt tách thành vòng riêng.
+ * Mỗi hệ có bộ sinh số ngẫu nhiên riêng, seed lấy từ Game::getEffectsRandom() (tách khỏi seed các màn chơi),
+ * nên hiệu ứng nền lặp lại được theo seed của phiên và không ảnh hưởng tới map được sinh.
+ * Toàn bộ hạt được vẽ bằng một lời gọi SDL_RenderGeometry duy nhất.
+ */
+class ParticleSystem {
+public:
+    ParticleSystem() {}
+
+    /**
+     * @brief Tạo count hạt rải đều trong vùng bay.
+     */
+    void init(const ParticleConfig& config, int count, uint64_t seed);
+
+    void update();
+    void draw(SDL_Renderer* renderer);
+
+    int size() const { return (int)mX.size(); }
+
+private:
+    void spawn(int i, bool anywhere);
+
+    ParticleConfig mConfig;
+    Random mRng;
+
+    std::vector<float> mX, mY;
+    std::vector<float> mVelocity; ///< Có dấu: âm khi bay lên.
+    std::vector<float> mWidth, mHeight;
+    std::vector<SDL_Color> mColor;
+
+    std::vector<SDL_Vertex> mVertices; ///< 4 đỉnh mỗi hạt, ghi lại mỗi khung hình.
+    std::vector<int> mIndices;         ///< 6 chỉ số mỗi hạt (2 tam giác), dựng một lần trong init().
+};
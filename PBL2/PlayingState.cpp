@@ -2,45 +2,66 @@
 #include "Game.h" 
 #include "GameOverState.h" 
 #include "MainMenuState.h" 
+#include "Trace.h"
 #include <fstream>
 #include <cstdio> 
 #include <iostream> 
-#include <cstdlib> // Cho rand()
 #include <sstream> // Cho stringstream
 #include <SDL_mixer.h> 
 
 const double PlayingState::EVENT_INTERVAL = 10.0;
 const double PlayingState::EVENT_WARNING_DURATION = 3.0;
 
+namespace {
+    // Bố cục panel phải (tọa độ y), dùng chung cho lớp tĩnh và phần chữ vẽ mỗi khung hình
+    const int PANEL_TITLE_Y = 60;
+    const int PANEL_MOVES_LABEL_Y = 140;
+    const int PANEL_MOVES_Y = 180;
+    const int PANEL_TIME_LABEL_Y = 260;
+    const int PANEL_TIME_Y = 300;
+
+    const int GLOW_RINGS = 15; // Số vòng viền mờ dần quanh bàn cờ
+}
+
 // Constructor 1 (Game Mới)
-PlayingState::PlayingState(Game* game, ResourceManager* resManager, int level, int gridDim, int numColors, int maxMoves, AlgorithmType algo, FillDirection fillDir)
+PlayingState::PlayingState(Game* game, ResourceManager* resManager, int level, int gridDim, int numColors, int maxMoves, AlgorithmType algo, FillDirection fillDir,
+    BoardShape shape)
     : GameState(game), mResManager(resManager), mPlayerLevel(level), mGridDim(gridDim), mNumColors(numColors),
-    mMaxMoves(maxMoves), mMoves(0), mGameWon(false), mGameLost(false), mIsHintActive(false), mHintColor({ 0,0,0,0 }),
-    mSavedElapsedTime(0.0), mIsEventWarningActive(false), mEventCellChangeCount(2)
+    mMaxMoves(maxMoves), mMoves(0), mGameWon(false), mGameLost(false), mHistoryCharge(MEM_UNDO_HISTORY), mIsHintActive(false), mHintColor({ 0,0,0,0 }), mCalibrationCancelled(false),
+    mSavedElapsedTime(0.0), mIsEventWarningActive(false), mEventCellChangeCount(2),
+    mPanelLayerLanguage(LANG_VI), mGlowLayerColor({ 0,0,0,0 }), mLayerResetCount(0)
 {
     Mix_VolumeMusic(MIX_MAX_VOLUME);
-    mGrid.init(mGridDim, mNumColors, algo, fillDir);
+    mResManager->prefetchResultSounds(); // Âm thanh thắng/thua chỉ cần khi hết màn, tải nền từ giờ
+    // Level pack chỉ có bàn ô vuông; các dạng khác sinh map (và lỗ) từ seed của màn
+    bool fromPack = (shape == SHAPE_SQUARE) && loadFromLevelPack(algo, fillDir);
+    if (!fromPack) {
+        uint64_t levelSeed = mGame->nextLevelSeed(mPlayerLevel);
+        std::cout << "Level " << mPlayerLevel << " seed: " << levelSeed << " (" << Topology::getShapeName(shape) << ")" << std::endl;
+        mGrid.init(mNumColors, algo, Topology::create(shape, fillDir, mGridDim, levelSeed), levelSeed);
+    }
 
     initUI();
     initParticles(); // <--- TRANG TRÍ
 
     resetTimer();
     mRandomEventTimer = std::chrono::steady_clock::now();
+    if (!fromPack) startCalibration();
     predictProgress();
     saveGameState();
 }
 
 // Constructor 2 (Load Game)
-PlayingState::PlayingState(Game* game, ResourceManager* resManager, int level, int gridDim, int numColors, int maxMoves, AlgorithmType algo, FillDirection fillDir,
-    int moves, double savedTime, const std::vector<std::vector<SDL_Color>>& initialGrid, const std::vector<std::vector<SDL_Color>>& currentGrid)
+PlayingState::PlayingState(Game* game, ResourceManager* resManager, int level, int gridDim, int numColors, int maxMoves, AlgorithmType algo, TopologyRef topology,
+    int moves, double savedTime, Board initialGrid, Board currentGrid)
     : GameState(game), mResManager(resManager), mPlayerLevel(level), mGridDim(gridDim), mNumColors(numColors),
-    mMaxMoves(maxMoves), mMoves(moves), mGameWon(false), mGameLost(false), mIsHintActive(false), mHintColor({ 0,0,0,0 }),
-    mSavedElapsedTime(savedTime), mIsEventWarningActive(false), mEventCellChangeCount(2)
+    mMaxMoves(maxMoves), mMoves(moves), mGameWon(false), mGameLost(false), mHistoryCharge(MEM_UNDO_HISTORY), mIsHintActive(false), mHintColor({ 0,0,0,0 }), mCalibrationCancelled(false),
+    mSavedElapsedTime(savedTime), mIsEventWarningActive(false), mEventCellChangeCount(2),
+    mPanelLayerLanguage(LANG_VI), mGlowLayerColor({ 0,0,0,0 }), mLayerResetCount(0)
 {
     Mix_VolumeMusic(MIX_MAX_VOLUME);
-    mGrid.init(mGridDim, mNumColors, algo, fillDir);
-    mGrid.setCells(currentGrid);
-    mGrid.setInitialGrid(initialGrid);
+    mResManager->prefetchResultSounds(); // Âm thanh thắng/thua chỉ cần khi hết màn, tải nền từ giờ
+    mGrid.load(makeBoardSnapshot(std::move(initialGrid)), std::move(currentGrid), mNumColors, algo, std::move(topology), mGame->nextLevelSeed(mPlayerLevel));
 
     initUI();
     initParticles(); // <--- TRANG TRÍ
@@ -50,34 +71,22 @@ PlayingState::PlayingState(Game* game, ResourceManager* resManager, int level, i
     predictProgress();
 }
 
-PlayingState::~PlayingState() {}
+PlayingState::~PlayingState() {
+    // Không chờ giải thử chạy hết ngân sách: báo dừng rồi chờ luồng nền thoát ở nút kế tiếp
+    mCalibrationCancelled = true;
+    if (mCalibration.valid()) mCalibration.wait();
+}
 
 // === 1. HÀM KHỞI TẠO HẠT (TRANG TRÍ) ===
 void PlayingState::initParticles() {
-    int areaW = SCREEN_WIDTH - UI_PANEL_WIDTH; // Chỉ bay ở vùng bàn cờ
-    for (int i = 0; i < 30; ++i) {
-        GameParticle p;
-        p.x = (float)(rand() % areaW);
-        p.y = (float)(rand() % SCREEN_HEIGHT);
-        p.size = 10 + rand() % 30;
-        p.speed = 0.2f + (rand() % 50) / 100.0f;
-        p.alpha = 20 + rand() % 40; // Mờ ảo
-        p.color = PALETTE[rand() % mNumColors];
-        mParticles.push_back(p);
-    }
-}
-
-// === 2. HÀM CẬP NHẬT HẠT ===
-void PlayingState::updateParticles() {
-    int areaW = SCREEN_WIDTH - UI_PANEL_WIDTH;
-    for (auto& p : mParticles) {
-        p.y -= p.speed; // Bay lên
-        if (p.y + p.size < 0) {
-            p.y = (float)SCREEN_HEIGHT;
-            p.x = (float)(rand() % areaW);
-            p.color = PALETTE[rand() % mNumColors];
-        }
-    }
+    ParticleConfig config;
+    config.area = { 0, 0, SCREEN_WIDTH - UI_PANEL_WIDTH, SCREEN_HEIGHT }; // Chỉ bay ở vùng bàn cờ
+    config.minSpeed = 0.2f; config.speedRange = 0.5f;
+    config.minWidth = 10; config.widthRange = 30;
+    config.square = true;
+    config.minAlpha = 20; config.alphaRange = 40; // Mờ ảo
+    config.colors.assign(PALETTE.begin(), PALETTE.begin() + mNumColors);
+    mParticles.init(config, 30, mGame->getEffectsRandom().nextU64());
 }
 
 void PlayingState::initUI() {
@@ -90,74 +99,110 @@ void PlayingState::initUI() {
     int gameBtnStartX = gameUIX + (gameUIW - gameBtnW) / 2;
 
     int currentY = SCREEN_HEIGHT - 20 - gameBtnH;
-    mUI.addButton("game_back_to_menu", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, "game_back_to_menu", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("game_back_to_menu", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, TXT_GAME_BACK_TO_MENU, BUTTON_GRAY, BUTTON_HIGHLIGHT);
 
     currentY -= (gameBtnH + gameBtnMargin);
-    mUI.addButton("game_replay_level", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, "game_replay_level", BUTTON_GREEN, BUTTON_HIGHLIGHT);
+    mUI.addButton("game_replay_level", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, TXT_GAME_REPLAY_LEVEL, BUTTON_GREEN, BUTTON_HIGHLIGHT);
 
     currentY -= (gameBtnH + gameBtnMargin);
-    mUI.addButton("game_hint", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, "game_hint", BUTTON_YELLOW, BUTTON_HIGHLIGHT);
+    mUI.addButton("game_hint", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, TXT_GAME_HINT, BUTTON_YELLOW, BUTTON_HIGHLIGHT);
 
     currentY -= (gameBtnH + gameBtnMargin);
-    mUI.addButton("game_undo", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, "game_undo", BUTTON_BLUE, BUTTON_HIGHLIGHT);
+    mUI.addButton("game_undo", { gameBtnStartX, currentY, gameBtnW, gameBtnH }, TXT_GAME_UNDO, BUTTON_BLUE, BUTTON_HIGHLIGHT);
 }
 
 void PlayingState::handleEvents(SDL_Event& e) {
-    if (mGrid.isAnimating() || mGameWon || mGameLost) return;
+    if (mGameWon || mGameLost) return;
+    // Không chặn thao tác trong lúc hoạt ảnh: nước đi được áp dụng ngay (xem requestMove)
+    const auto inputTime = std::chrono::steady_clock::now();
 
     std::string action = mUI.handleEvents(e);
     if (!action.empty()) {
         if (action == "game_back_to_menu") { saveGameState(); mGame->changeState(new MainMenuState(mGame)); }
         else if (action == "game_replay_level") retryCurrentLevel();
-        else if (action == "game_hint") { mHintColor = mGrid.findBestMove(); mIsHintActive = true; }
+        else if (action == "game_hint") {
+            TRACE_INSTANT("hint_pressed");
+            // Dùng kết quả tính sẵn nếu có; nếu worker chưa kịp xong thì tính tham lam tại chỗ
+            if (!mHintWorker.getHint(mGrid.getRevision(), mHintColor)) mHintColor = mGrid.findBestMove();
+            mIsHintActive = true;
+        }
         else if (action == "game_undo") undoLastMove();
         return;
     }
 
     if (e.type == SDL_MOUSEBUTTONDOWN) {
         if (mGrid.isClickInBounds(e.button.x, e.button.y)) {
-            // Âm thanh ngẫu nhiên
-            Mix_Chunk* fillSfx = mResManager->getRandomFillSound();
-            if (fillSfx) Mix_PlayChannel(-1, fillSfx, 0);
-
-            startFloodFill(mGrid.getColorFromClick(e.button.x, e.button.y));
+            requestMove(mGrid.getColorFromClick(e.button.x, e.button.y), inputTime);
         }
         return;
     }
     if (e.type == SDL_KEYDOWN) {
-        if (e.key.keysym.sym == SDLK_z && (e.key.keysym.mod & KMOD_CTRL)) undoLastMove();
+        SDL_Keycode key = e.key.keysym.sym;
+        if (key == SDLK_z && (e.key.keysym.mod & KMOD_CTRL)) undoLastMove();
+        else if (key == SDLK_SPACE) finishAnimationsNow();
+        else if (key >= SDLK_1 && key <= SDLK_8) {
+            // Phím 1..8 chọn màu theo thứ tự trong bảng màu của màn chơi
+            int index = key - SDLK_1;
+            if (index < mNumColors && index < (int)PALETTE.size()) requestMove(PALETTE[index], inputTime);
+        }
     }
 }
 
+void PlayingState::requestMove(const SDL_Color& newColor, [[maybe_unused]] std::chrono::steady_clock::time_point inputTime) {
+    TRACE_INSTANT("move_input");
+    // Lưới luôn ở trạng thái cuối nên nước đi được tính ngay trên bàn cờ sau các nước trước, kể cả khi hoạt ảnh
+    // của chúng chưa phát xong (Grid nối phần tô mới vào hoạt ảnh). Chỉ kết quả thắng/thua chờ hoạt ảnh, nên
+    // thao tác sau khi ván đã phân định bị bỏ qua (không phát âm thanh).
+    if (mGrid.isWinConditionMet() || mMoves >= mMaxMoves) return;
+
+    // Âm thanh ngẫu nhiên
+    Mix_Chunk* fillSfx = mResManager->getRandomFillSound(mGame->getEffectsRandom());
+    if (fillSfx) Mix_PlayChannel(-1, fillSfx, 0);
+
+    startFloodFill(newColor);
+    // Độ trễ từ lúc nhận thao tác đến khi lưới cập nhật
+    TRACE_COUNTER("input_latency_ms", (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inputTime).count()));
+}
+
+void PlayingState::finishAnimationsNow() {
+    TRACE_SCOPE("PlayingState::finishAnimationsNow");
+    mGrid.skipFillAnimation();
+    checkWinCondition();
+}
+
 void PlayingState::update() {
+    if (mCalibration.valid() && mCalibration.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        applyCalibration(mCalibration.get());
+    }
     if (mGameWon || mGameLost) return;
 
     updateTimer();
     updateRandomEvent();
-    updateParticles(); // <--- CẬP NHẬT TRANG TRÍ
+    mParticles.update(); // <--- CẬP NHẬT TRANG TRÍ
 
     if (mGrid.isAnimating()) {
-        bool finished = mGrid.animateFillStep();
-        if (finished) {
-            checkWinCondition();
-            predictProgress();
-            saveGameState();
-        }
+        // Dự đoán và lưu đã làm ngay khi đi; chỉ kết quả thắng/thua chờ hoạt ảnh phát xong
+        if (mGrid.animateFillStep()) checkWinCondition();
     }
     else {
         checkWinCondition();
     }
+
+    updateHint();
 }
 
-// === 3. HÀM VẼ TRANG TRÍ ===
-void PlayingState::drawDecoration(SDL_Renderer* renderer) {
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    for (const auto& p : mParticles) {
-        SDL_SetRenderDrawColor(renderer, p.color.r, p.color.g, p.color.b, p.alpha);
-        SDL_Rect r = { (int)p.x, (int)p.y, p.size, p.size };
-        SDL_RenderFillRect(renderer, &r);
+void PlayingState::updateHint() {
+    if (mGameWon || mGameLost) return;
+
+    // Lưới đã là trạng thái cuối ngay khi đi (kể cả lúc hoạt ảnh còn chạy), sau hoàn tác hoặc sự kiện đổi màu:
+    // yêu cầu tính gợi ý mới
+    if (mHintWorker.getRequestedRevision() != mGrid.getRevision()) {
+        mHintWorker.request(mGrid.getCells(), mGrid.getTopology(), mNumColors, mGrid.getRevision());
+    }
+    // Gợi ý đang hiển thị được thay bằng kết quả nhìn trước sâu hơn khi có
+    if (mIsHintActive) {
+        mHintWorker.getHint(mGrid.getRevision(), mHintColor);
     }
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 }
 
 void PlayingState::draw(SDL_Renderer* renderer) {
@@ -166,18 +211,19 @@ void PlayingState::draw(SDL_Renderer* renderer) {
     SDL_RenderClear(renderer);
 
     // 2. Vẽ hiệu ứng nền (Dưới Grid)
-    drawDecoration(renderer);
+    mParticles.draw(renderer);
 
-    // 3. Vẽ Tấm Nền UI (Bên phải) - Đè lên hiệu ứng nền
-    SDL_Rect uiArea = { SCREEN_WIDTH - UI_PANEL_WIDTH, 0, UI_PANEL_WIDTH, SCREEN_HEIGHT };
-    SDL_SetRenderDrawColor(renderer, 34, 42, 53, 255);
-    SDL_RenderFillRect(renderer, &uiArea);
+    // Các lớp tĩnh phải tạo lại nếu renderer vừa reset render target
+    if (mLayerResetCount != mGame->getRenderResetCount()) {
+        mPanelLayer.release();
+        mGlowLayer.release();
+        mLayerResetCount = mGame->getRenderResetCount();
+    }
 
-    SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255); // Kẻ dọc
-    SDL_RenderDrawLine(renderer, uiArea.x, 0, uiArea.x, SCREEN_HEIGHT);
+    // 3. Tấm nền UI (bên phải) kèm nhãn tĩnh - Đè lên hiệu ứng nền
+    drawPanelLayer(renderer);
 
-    // 4. Vẽ Viền Phát Sáng Quanh Grid (Glow Border)
-    // Lấy màu của người chơi hiện tại (ô 0,0)
+    // 4. Viền phát sáng quanh Grid theo màu người chơi hiện tại (ô 0,0)
     SDL_Color playerColor = { 255, 255, 255, 255 };
     if (!mGrid.getCells().empty()) {
         playerColor = mGrid.getCells()[0][0];
@@ -187,48 +233,24 @@ void PlayingState::draw(SDL_Renderer* renderer) {
     int gridSizePx = 680;
     int mapX = (mapAreaW - gridSizePx) / 2;
     int mapY = (SCREEN_HEIGHT - gridSizePx) / 2;
-
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    for (int i = 0; i < 15; ++i) { // 15 lớp viền mờ dần
-        int alpha = 100 - (i * 6);
-        if (alpha < 0) alpha = 0;
-        SDL_SetRenderDrawColor(renderer, playerColor.r, playerColor.g, playerColor.b, alpha);
-        SDL_Rect glowRect = { mapX - i, mapY - i, gridSizePx + i * 2, gridSizePx + i * 2 };
-        SDL_RenderDrawRect(renderer, &glowRect);
-    }
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    drawGlowLayer(renderer, playerColor, mapX, mapY, gridSizePx);
 
     // 5. Vẽ Grid (Nằm giữa khung viền)
     bool showStart = (mMoves == 0);
     mGrid.draw(renderer, true, showStart, mIsEventWarningActive);
 
-    // 6. Vẽ UI Info
-    int centerX = uiArea.x + uiArea.w / 2;
-    int y_offset = 60;
-    const int PADDING_SECTION = 60;
-
-    // Tiêu đề Level
+    // 6. Vẽ phần UI thay đổi theo lượt/thời gian
+    int centerX = SCREEN_WIDTH - UI_PANEL_WIDTH / 2;
     TTF_Font* fontTitle = mResManager->getFontTitle();
     TTF_Font* fontUI = mResManager->getFontUI();
     std::stringstream ss;
-    ss << mResManager->getText("game_level") << " " << mPlayerLevel;
-    drawText(renderer, ss.str(), centerX, y_offset, fontTitle, TEXT_WHITE);
-    y_offset += PADDING_SECTION + 20;
-
-    // Moves
-    drawText(renderer, mResManager->getText("game_moves"), centerX, y_offset, fontUI, PALETTE[3]);
-    y_offset += 40;
-    ss.str(""); ss << mMoves << " / " << mMaxMoves;
-    drawText(renderer, ss.str(), centerX, y_offset, fontTitle, TEXT_WHITE);
-    y_offset += PADDING_SECTION + 20;
-
-    // Time
-    drawText(renderer, mResManager->getText("game_time"), centerX, y_offset, fontUI, PALETTE[5]);
-    y_offset += 40;
+    ss << mMoves << " / " << mMaxMoves;
+    drawText(renderer, ss.str(), centerX, PANEL_MOVES_Y, fontTitle, TEXT_WHITE);
+
     int totalSeconds = static_cast<int>(mElapsedTime.count());
     int minutes = totalSeconds / 60; int seconds = totalSeconds % 60;
     ss.str(""); ss << std::setfill('0') << std::setw(2) << minutes << ":" << std::setfill('0') << std::setw(2) << seconds;
-    drawText(renderer, ss.str(), centerX, y_offset, fontTitle, TEXT_WHITE);
+    drawText(renderer, ss.str(), centerX, PANEL_TIME_Y, fontTitle, TEXT_WHITE);
 
     mUI.draw(renderer);
 
@@ -238,7 +260,7 @@ void PlayingState::draw(SDL_Renderer* renderer) {
         if (undoButton) {
             int hintBoxY = undoButton->getRect().y - 70;
             int hintTextY = hintBoxY - 35;
-            drawText(renderer, mResManager->getText("game_ai_suggestion"), centerX, hintTextY, fontUI, PALETTE[3]);
+            drawText(renderer, mResManager->getText(TXT_GAME_AI_SUGGESTION), centerX, hintTextY, fontUI, PALETTE[3]);
             SDL_Rect hintColorRect = { centerX - 25, hintBoxY, 50, 50 };
             SDL_SetRenderDrawColor(renderer, mHintColor.r, mHintColor.g, mHintColor.b, 255);
             SDL_RenderFillRect(renderer, &hintColorRect);
@@ -248,6 +270,75 @@ void PlayingState::draw(SDL_Renderer* renderer) {
     }
 }
 
+void PlayingState::drawPanelLayer(SDL_Renderer* renderer) {
+    int panelX = SCREEN_WIDTH - UI_PANEL_WIDTH;
+    if (mPanelLayer.isValid() && mPanelLayerLanguage == mResManager->getLanguage()) {
+        mPanelLayer.draw(renderer, panelX, 0);
+        return;
+    }
+
+    mPanelLayerLanguage = mResManager->getLanguage();
+    if (mPanelLayer.beginRedraw(renderer, UI_PANEL_WIDTH, SCREEN_HEIGHT)) {
+        renderPanelStatic(renderer, 0);
+        mPanelLayer.endRedraw(renderer);
+        mPanelLayer.draw(renderer, panelX, 0);
+    }
+    else {
+        renderPanelStatic(renderer, panelX); // Không có render target: vẽ trực tiếp
+    }
+}
+
+void PlayingState::drawGlowLayer(SDL_Renderer* renderer, const SDL_Color& playerColor, int mapX, int mapY, int gridSizePx) {
+    const int margin = GLOW_RINGS - 1;
+    if (mGlowLayer.isValid() && areColorsEqual(mGlowLayerColor, playerColor)) {
+        mGlowLayer.draw(renderer, mapX - margin, mapY - margin);
+        return;
+    }
+
+    mGlowLayerColor = playerColor;
+    if (mGlowLayer.beginRedraw(renderer, gridSizePx + margin * 2, gridSizePx + margin * 2)) {
+        // Các vòng không chồng nhau nên ghi thẳng (không blend) màu + alpha vào lớp trong suốt;
+        // lúc copy ra màn hình texture mới được blend
+        renderGlow(renderer, playerColor, margin, margin, gridSizePx);
+        mGlowLayer.endRedraw(renderer);
+        mGlowLayer.draw(renderer, mapX - margin, mapY - margin);
+    }
+    else {
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        renderGlow(renderer, playerColor, mapX, mapY, gridSizePx);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+    }
+}
+
+void PlayingState::renderPanelStatic(SDL_Renderer* renderer, int originX) {
+    SDL_Rect uiArea = { originX, 0, UI_PANEL_WIDTH, SCREEN_HEIGHT };
+    SDL_SetRenderDrawColor(renderer, 34, 42, 53, 255);
+    SDL_RenderFillRect(renderer, &uiArea);
+
+    SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255); // Kẻ dọc
+    SDL_RenderDrawLine(renderer, uiArea.x, 0, uiArea.x, SCREEN_HEIGHT);
+
+    int centerX = uiArea.x + uiArea.w / 2;
+    TTF_Font* fontTitle = mResManager->getFontTitle();
+    TTF_Font* fontUI = mResManager->getFontUI();
+
+    std::stringstream ss;
+    ss << mResManager->getText(TXT_GAME_LEVEL) << " " << mPlayerLevel;
+    drawText(renderer, ss.str(), centerX, PANEL_TITLE_Y, fontTitle, TEXT_WHITE);
+    drawText(renderer, mResManager->getText(TXT_GAME_MOVES), centerX, PANEL_MOVES_LABEL_Y, fontUI, PALETTE[3]);
+    drawText(renderer, mResManager->getText(TXT_GAME_TIME), centerX, PANEL_TIME_LABEL_Y, fontUI, PALETTE[5]);
+}
+
+void PlayingState::renderGlow(SDL_Renderer* renderer, const SDL_Color& playerColor, int originX, int originY, int gridSizePx) {
+    for (int i = 0; i < GLOW_RINGS; ++i) { // Các lớp viền mờ dần
+        int alpha = 100 - (i * 6);
+        if (alpha < 0) alpha = 0;
+        SDL_SetRenderDrawColor(renderer, playerColor.r, playerColor.g, playerColor.b, alpha);
+        SDL_Rect glowRect = { originX - i, originY - i, gridSizePx + i * 2, gridSizePx + i * 2 };
+        SDL_RenderDrawRect(renderer, &glowRect);
+    }
+}
+
 void PlayingState::resetTimer() {
     mSavedElapsedTime = 0.0;
     mElapsedTime = std::chrono::duration<double>::zero();
@@ -280,6 +371,7 @@ void PlayingState::updateRandomEvent() {
         if (warningTime > EVENT_WARNING_DURATION) {
             mGridHistory.push(mGrid.getCells());
             mMovesHistory.push(mMoves);
+            updateHistoryCharge();
             mGrid.executeColorChangeEvent();
             mIsEventWarningActive = false;
             mEventCellChangeCount++;
@@ -294,20 +386,26 @@ void PlayingState::startFloodFill(const SDL_Color& newColor) {
     mIsHintActive = false;
     mGridHistory.push(mGrid.getCells());
     mMovesHistory.push(mMoves);
+    updateHistoryCharge();
     if (mGrid.startFloodFill(newColor)) {
+        mHintWorker.cancel();
         mMoves++;
-        if (mGrid.isAnimating() == false) {
-            checkWinCondition();
-            predictProgress();
-            saveGameState();
-        }
+        predictProgress();
+        saveGameState();
+        if (!mGrid.isAnimating()) checkWinCondition();
     }
     else {
         mGridHistory.pop();
         mMovesHistory.pop();
+        updateHistoryCharge();
     }
 }
 
+void PlayingState::updateHistoryCharge() {
+    // Mọi lưới trong lịch sử cùng kích thước với lưới hiện tại
+    mHistoryCharge.set(mGridHistory.size() * nestedVectorBytes(mGrid.getCells()));
+}
+
 void PlayingState::checkWinCondition() {
     if (mGameWon || mGameLost) return;
     if (mGrid.isWinConditionMet()) {
@@ -328,8 +426,9 @@ void PlayingState::checkWinCondition() {
 
 void PlayingState::undoLastMove() {
     if (!mGridHistory.empty() && !mMovesHistory.empty()) {
-        mGrid.setCells(mGridHistory.top()); mGridHistory.pop();
+        mGrid.setCells(std::move(mGridHistory.top())); mGridHistory.pop();
         mMoves = mMovesHistory.top(); mMovesHistory.pop();
+        updateHistoryCharge();
         mIsHintActive = false; predictProgress(); saveGameState();
     }
 }
@@ -340,26 +439,84 @@ void PlayingState::retryCurrentLevel() {
     resetTimer();
     while (!mGridHistory.empty()) mGridHistory.pop();
     while (!mMovesHistory.empty()) mMovesHistory.pop();
+    updateHistoryCharge();
     mRandomEventTimer = std::chrono::steady_clock::now();
     mIsEventWarningActive = false; mEventCellChangeCount = 2;
     predictProgress(); saveGameState();
 }
 
+bool PlayingState::loadFromLevelPack(AlgorithmType algo, FillDirection fillDir) {
+    LevelRecord record;
+    if (!mGame->getLevelPack().findLevel(mPlayerLevel, mNumColors, fillDir, record) || record.dim != mGridDim) {
+        return false;
+    }
+
+    Board cells;
+    record.unpackCells(cells);
+    // Seed của màn vẫn quyết định sự kiện đổi màu; lưới lấy từ pack thay vì sinh lại
+    mGrid.load(makeBoardSnapshot(std::move(cells)), mNumColors, algo, Topology::create(SHAPE_SQUARE, fillDir, mGridDim), record.seed);
+    mMaxMoves = mGame->getMaxMovesForSolution(record.bestMoves);
+    std::cout << "Level " << mPlayerLevel << " from pack: seed " << record.seed << ", greedy " << record.greedyMoves
+        << ", best " << record.bestMoves << ", maxMoves " << mMaxMoves << std::endl;
+    return true;
+}
+
+void PlayingState::startCalibration() {
+    // maxMoves truyền vào là giá trị tạm theo công thức; thay bằng độ dài lời giải thực của lưới này
+    // Ngân sách theo số nút chỉ phụ thuộc cỡ bàn cờ, nên cùng seed luôn cho cùng giới hạn số bước trên mọi máy
+    BoardSnapshot cells = mGrid.getInitialSnapshot();
+    TopologyRef topology = mGrid.getTopology();
+    if (LevelCalibrator::fitsInFrame(mGridDim)) {
+        long long nodeBudget = LevelCalibrator::nodeBudgetForWork(CALIBRATION_SYNC_WORK, topology->getCellCount());
+        applyCalibration(LevelCalibrator::calibrateNodes(*cells, *topology, mNumColors, nodeBudget));
+    }
+    else {
+        // Luồng nền giữ tham chiếu tới lưới ban đầu và topology bất biến, không cần sao chép
+        int numColors = mNumColors;
+        long long nodeBudget = LevelCalibrator::nodeBudgetForWork(CALIBRATION_ASYNC_WORK, topology->getCellCount());
+        const std::atomic<bool>* cancelled = &mCalibrationCancelled;
+        mCalibration = std::async(std::launch::async, [cells, topology, numColors, nodeBudget, cancelled] {
+            return LevelCalibrator::calibrateNodes(*cells, *topology, numColors, nodeBudget, cancelled);
+        });
+    }
+}
+
+void PlayingState::applyCalibration(const CalibrationResult& result) {
+    if (result.bestMoves <= 0) return;
+    int calibrated = mGame->getMaxMovesForSolution(result.bestMoves);
+    std::cout << "Level " << mPlayerLevel << " solver: greedy " << result.greedyMoves << ", best " << result.bestMoves
+        << " (depth " << result.bestDepth << "), maxMoves " << mMaxMoves << " -> " << calibrated << std::endl;
+    // Nếu người chơi đã đi trước khi kết quả về, vẫn chừa ít nhất một bước
+    mMaxMoves = std::max(calibrated, mMoves + 1);
+    if (mGameWon || mGameLost) return;
+    predictProgress();
+    saveGameState();
+}
+
 void PlayingState::predictProgress() {
     mPredictionResult = mGrid.predictProgress();
     mPredictionResult.possibleToWin = (mPredictionResult.predictedSteps <= (mMaxMoves - mMoves));
 }
 
-void PlayingState::deleteSaveFile() { remove("savegame.txt"); mGame->setSaveFileExists(false); }
+void PlayingState::deleteSaveFile() { mGame->deleteSaveFile(); }
 
 void PlayingState::saveGameState() {
-    if (mGameWon || mGameLost) return;
+    if (mGameWon || mGameLost || mGame->isHeadless()) return;
+    TRACE_SCOPE("PlayingState::saveGameState");
     std::ofstream saveFile("savegame.txt");
     if (!saveFile.is_open()) return;
     updateTimer();
     double timeToSave = mElapsedTime.count();
     saveFile << "Level: " << mPlayerLevel << "\nGridDimension: " << mGridDim << "\nNumColors: " << mNumColors
-        << "\nMoves: " << mMoves << "\nMaxMoves: " << mMaxMoves << "\nElapsedTime: " << timeToSave << "\nInitialGrid:\n";
+        << "\nMoves: " << mMoves << "\nMaxMoves: " << mMaxMoves << "\nElapsedTime: " << timeToSave;
+    // Dạng bàn cờ (file lưu cũ không có dòng này được coi là ô vuông); bàn có lỗ lưu thêm mặt nạ theo hàng
+    const Topology& topology = *mGrid.getTopology();
+    saveFile << "\nShape: " << topology.getShape() << "\n";
+    if (topology.getShape() == SHAPE_MASKED) {
+        saveFile << "Mask:\n";
+        for (int y = 0; y < mGridDim; ++y) { for (int x = 0; x < mGridDim; ++x) saveFile << (topology.isActive(x, y) ? 1 : 0) << " "; saveFile << "\n"; }
+    }
+    saveFile << "InitialGrid:\n";
     const auto& initialGrid = mGrid.getInitialCells();
     for (int y = 0; y < mGridDim; ++y) { for (int x = 0; x < mGridDim; ++x) saveFile << (int)initialGrid[x][y].r << " " << (int)initialGrid[x][y].g << " " << (int)initialGrid[x][y].b << " "; saveFile << "\n"; }
     saveFile << "CurrentGrid:\n";
@@ -2,38 +2,40 @@
 
 #include "GameState.h"
 #include "Grid.h"
+#include "HintWorker.h"
+#include "LevelCalibrator.h"
 #include "UIManager.h"
 #include "ResourceManager.h"
 #include "Constants.h"
+#include "ParticleSystem.h"
+#include "RenderLayer.h"
+#include <atomic>
 #include <chrono>
+#include <future>
 #include <stack>
 #include <vector> 
 
-// Struct cho hạt trang trí (Hiệu ứng nền)
-struct GameParticle {
-    float x, y;
-    float speed;
-    int size;
-    int alpha;
-    SDL_Color color;
-};
-
 class Game;
 
 class PlayingState : public GameState {
 public:
-    PlayingState(Game* game, ResourceManager* resManager, int level, int gridDim, int numColors, int maxMoves, AlgorithmType algo, FillDirection fillDir);
-
     PlayingState(Game* game, ResourceManager* resManager, int level, int gridDim, int numColors, int maxMoves, AlgorithmType algo, FillDirection fillDir,
-        int moves, double savedTime, const std::vector<std::vector<SDL_Color>>& initialGrid, const std::vector<std::vector<SDL_Color>>& currentGrid);
+        BoardShape shape);
+
+    PlayingState(Game* game, ResourceManager* resManager, int level, int gridDim, int numColors, int maxMoves, AlgorithmType algo, TopologyRef topology,
+        int moves, double savedTime, Board initialGrid, Board currentGrid);
 
     virtual ~PlayingState();
 
     virtual void handleEvents(SDL_Event& e) override;
     virtual void update() override;
     virtual void draw(SDL_Renderer* renderer) override;
+    virtual const char* getName() const override { return "PlayingState"; }
+    virtual UIManager* getUI() override { return &mUI; }
+    virtual bool getCellCenter(int gx, int gy, int& x, int& y) const override { return mGrid.getCellCenter(gx, gy, x, y); }
 
     void saveGameState();
+    void updateHistoryCharge();
     void deleteSaveFile();
     void retryCurrentLevel();
 
@@ -55,9 +57,15 @@ private:
 
     std::stack<std::vector<std::vector<SDL_Color>>> mGridHistory;
     std::stack<int> mMovesHistory;
+    MemoryCharge mHistoryCharge; // Số byte các lưới trong mGridHistory
 
     bool mIsHintActive;
+
     SDL_Color mHintColor;
+    HintWorker mHintWorker; // Tính sẵn gợi ý cho lưới hiện tại trên luồng nền
+
+    std::atomic<bool> mCalibrationCancelled;     // Báo luồng giải thử dừng khi trạng thái bị hủy (khai báo trước mCalibration)
+    std::future<CalibrationResult> mCalibration; // Giải thử màn lớn trên luồng nền để đặt mMaxMoves
 
     std::chrono::steady_clock::time_point mLevelStartTime;
     std::chrono::duration<double> mElapsedTime;
@@ -70,7 +78,14 @@ private:
     int mEventCellChangeCount;
 
     // === BIẾN TRANG TRÍ ===
-    std::vector<GameParticle> mParticles;
+    ParticleSystem mParticles; ///< Hạt trang trí bay dưới bàn cờ
+
+    // === LỚP TĨNH VẼ SẴN (chỉ vẽ lại khi khóa tương ứng đổi) ===
+    RenderLayer mPanelLayer; ///< Nền panel phải, vạch kẻ và các nhãn tĩnh; khóa: ngôn ngữ
+    RenderLayer mGlowLayer;  ///< 15 vòng viền phát sáng quanh bàn cờ; khóa: màu người chơi
+    Language mPanelLayerLanguage;
+    SDL_Color mGlowLayerColor;
+    int mLayerResetCount; ///< Game::getRenderResetCount() lúc tạo các lớp
 
     void initUI();
     void resetTimer();
@@ -79,11 +94,19 @@ private:
 
     // === HÀM TRANG TRÍ ===
     void initParticles();
-    void updateParticles();
-    void drawDecoration(SDL_Renderer* renderer);
+    void drawPanelLayer(SDL_Renderer* renderer);
+    void drawGlowLayer(SDL_Renderer* renderer, const SDL_Color& playerColor, int mapX, int mapY, int gridSizePx);
+    void renderPanelStatic(SDL_Renderer* renderer, int originX);
+    void renderGlow(SDL_Renderer* renderer, const SDL_Color& playerColor, int originX, int originY, int gridSizePx);
 
+    void requestMove(const SDL_Color& newColor, std::chrono::steady_clock::time_point inputTime);
+    void finishAnimationsNow();
     void startFloodFill(const SDL_Color& newColor);
     void checkWinCondition();
     void undoLastMove();
     void predictProgress();
+    void updateHint();
+    bool loadFromLevelPack(AlgorithmType algo, FillDirection fillDir);
+    void startCalibration();
+    void applyCalibration(const CalibrationResult& result);
 };
\ No newline at end of file
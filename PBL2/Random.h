@@ -0,0 +1,103 @@
+﻿#pragma once
+
+#include <cstdint>
+
+/**
+ * @class Random
+ * @brief Bộ sinh số ngẫu nhiên xoshiro128** có seed tường minh.
+ *
+ * Thay cho rand() toàn cục: mỗi phiên chơi (và mỗi Grid) giữ một bộ sinh riêng,
+ * nên cùng một seed luôn cho ra cùng một bản đồ, cùng sự kiện đổi màu và cùng hiệu ứng nền.
+ * Thỏa mãn UniformRandomBitGenerator nên dùng được với std::shuffle.
+ */
+class Random {
+public:
+    using result_type = uint32_t;
+
+    explicit Random(uint64_t seed = 0) { setSeed(seed); }
+
+    /**
+     * @brief Đặt lại trạng thái từ seed (trạng thái 128 bit được trải từ seed bằng splitmix64).
+     */
+    void setSeed(uint64_t seed) {
+        mSeed = seed;
+        uint64_t z = seed;
+        for (int i = 0; i < 4; ++i) {
+            mState[i] = (uint32_t)(splitmix64(z) >> 32);
+        }
+    }
+
+    uint64_t getSeed() const { return mSeed; }
+
+    /**
+     * @brief Tách một seed độc lập cho luồng số stream từ seed gốc (trộn bằng splitmix64).
+     *
+     * Dùng để mỗi nơi cần số ngẫu nhiên (màn chơi, map AI, hiệu ứng) có chuỗi riêng chỉ phụ thuộc
+     * vào seed của phiên, không phụ thuộc vào việc nơi khác đã rút bao nhiêu số.
+     */
+    static uint64_t deriveSeed(uint64_t seed, uint64_t stream) {
+        uint64_t mixed = splitmix64(seed) ^ stream;
+        return splitmix64(mixed);
+    }
+
+    /**
+     * @brief Sinh 32 bit ngẫu nhiên tiếp theo.
+     */
+    uint32_t next() {
+        const uint32_t result = rotl(mState[1] * 5, 7) * 9;
+        const uint32_t t = mState[1] << 9;
+        mState[2] ^= mState[0];
+        mState[3] ^= mState[1];
+        mState[1] ^= mState[2];
+        mState[0] ^= mState[3];
+        mState[2] ^= t;
+        mState[3] = rotl(mState[3], 11);
+        return result;
+    }
+
+    uint64_t nextU64() {
+        uint64_t hi = next();
+        return (hi << 32) | next();
+    }
+
+    /**
+     * @brief Số nguyên trong [0, bound). Dùng phép nhân-dịch (Lemire) thay cho phép chia lấy dư.
+     */
+    int nextInt(int bound) {
+        if (bound <= 0) return 0;
+        return (int)(((uint64_t)next() * (uint32_t)bound) >> 32);
+    }
+
+    /**
+     * @brief Số nguyên trong [lo, hi] (bao gồm cả hai đầu).
+     */
+    int nextInt(int lo, int hi) {
+        return lo + nextInt(hi - lo + 1);
+    }
+
+    /**
+     * @brief Số thực trong [0, 1).
+     */
+    float nextFloat() {
+        return (next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+    result_type operator()() { return next(); }
+
+private:
+    static uint32_t rotl(uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t mSeed;
+    uint32_t mState[4];
+};
@@ -0,0 +1,75 @@
+﻿#pragma once
+
+#include "MemoryStats.h"
+#include <SDL.h>
+
+/**
+ * @class RenderLayer
+ * @brief Một lớp hình tĩnh được vẽ sẵn vào texture render-target rồi chỉ copy ra mỗi khung hình.
+ *
+ * Người dùng tự quyết định khi nào lớp hết hạn (invalidate) và vẽ lại nội dung giữa
+ * beginRedraw()/endRedraw() với tọa độ tính từ góc trên trái của lớp. Nếu renderer không hỗ trợ
+ * render target, beginRedraw() trả về false và người gọi vẽ trực tiếp như cũ.
+ */
+class RenderLayer {
+public:
+    RenderLayer() : mTexture(nullptr), mPrevTarget(nullptr), mWidth(0), mHeight(0), mValid(false), mCharge(MEM_TEXTURES) {}
+    ~RenderLayer() { release(); }
+
+    RenderLayer(const RenderLayer&) = delete;
+    RenderLayer& operator=(const RenderLayer&) = delete;
+
+    bool isValid() const { return mValid && mTexture; }
+    void invalidate() { mValid = false; }
+
+    /**
+     * @brief Chuyển renderer sang vẽ vào lớp (tạo texture nếu cần) và xóa lớp về trong suốt.
+     * @return false nếu không tạo được render target.
+     */
+    bool beginRedraw(SDL_Renderer* renderer, int w, int h) {
+        if (!mTexture || w != mWidth || h != mHeight) {
+            release();
+            mTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+            if (!mTexture) return false;
+            SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);
+            mWidth = w;
+            mHeight = h;
+            mCharge.set((size_t)w * h * 4);
+        }
+        mPrevTarget = SDL_GetRenderTarget(renderer);
+        if (SDL_SetRenderTarget(renderer, mTexture) != 0) return false;
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        SDL_RenderClear(renderer);
+        return true;
+    }
+
+    void endRedraw(SDL_Renderer* renderer) {
+        SDL_SetRenderTarget(renderer, mPrevTarget);
+        mPrevTarget = nullptr;
+        mValid = true;
+    }
+
+    void draw(SDL_Renderer* renderer, int x, int y) const {
+        if (!mTexture) return;
+        SDL_Rect dst = { x, y, mWidth, mHeight };
+        SDL_RenderCopy(renderer, mTexture, nullptr, &dst);
+    }
+
+    /**
+     * @brief Hủy texture (khi thiết bị render bị reset, texture cũ không còn dùng được).
+     */
+    void release() {
+        if (mTexture) SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+        mValid = false;
+        mCharge.set(0);
+    }
+
+private:
+    SDL_Texture* mTexture;
+    SDL_Texture* mPrevTarget;
+    int mWidth, mHeight;
+    bool mValid;
+    MemoryCharge mCharge;
+};
@@ -2,12 +2,26 @@
 
 #include <SDL_ttf.h>
 #include "Constants.h"
+#include "Random.h"
+#include "TextId.h"
 #include <iostream>
-#include <map>
+#include <atomic>
+#include <future>
 #include <string>
+#include <string_view>
 #include <vector> // <--- CẦN THƯ VIỆN NÀY
 #include <SDL_mixer.h> 
 
+/**
+ * @brief Thời gian (ms) của từng nhóm tài nguyên tải nền lúc khởi động. Các nhóm chạy song song
+ * nên tổng thời gian chờ gần bằng nhóm chậm nhất chứ không phải tổng các nhóm.
+ */
+struct AssetLoadTimings {
+    double fontsMs = 0.0;
+    double soundsMs = 0.0;
+    double musicMs = 0.0;
+};
+
 class ResourceManager {
 private:
     TTF_Font* mFontTitle;
@@ -23,8 +37,20 @@ private:
     // === THÊM DANH SÁCH ÂM THANH TÔ MÀU ===
     std::vector<Mix_Chunk*> mFillSounds;
 
-    std::map<std::string, std::map<Language, std::string>> mTranslations;
     Language mCurrentLanguage;
+    bool mFontsLoaded; ///< false trong lúc khởi động: setLanguage chỉ ghi nhận ngôn ngữ, font do luồng nền mở.
+
+    // Tải nền lúc khởi động
+    std::vector<std::future<void>> mLoadTasks;
+    std::atomic<int> mLoadTasksDone;
+    AssetLoadTimings mLoadTimings; ///< Mỗi tác vụ ghi trường riêng của nó, chỉ đọc sau finishAsyncLoad.
+
+    // Âm thanh thắng/thua chỉ dùng khi hết màn: không tải lúc khởi động mà nạp trước khi vào màn chơi
+    std::future<void> mResultSoundsTask;
+    bool mResultSoundsReady;
+
+    void loadResultSounds();
+    void ensureResultSounds();
 
 public:
     ResourceManager();
@@ -32,7 +58,30 @@ public:
 
     bool loadFonts(const std::string& path);
     void freeFonts();
-    void loadTranslations();
+    static std::string getFontFile(Language lang);
+
+    /**
+     * @brief Bắt đầu tải trên hai luồng nền: một luồng mở font, một luồng tải âm thanh tô màu rồi nhạc nền.
+     *
+     * Font của ngôn ngữ hiện tại được mở trên một luồng duy nhất vì SDL_ttf dùng chung
+     * một FT_Library; âm thanh và nhạc được tải nối tiếp vì SDL_mixer cũng không an toàn khi tải song song.
+     * Trong lúc chờ, luồng chính chỉ được dùng getLoadProgress()/isLoadFinished().
+     */
+    void beginAsyncLoad(const std::string& musicPath);
+    float getLoadProgress() const;
+    bool isLoadFinished() const;
+
+    /**
+     * @brief Chờ mọi tác vụ tải nền xong.
+     * @return false nếu không mở được font nào (game không thể chạy tiếp).
+     */
+    bool finishAsyncLoad();
+    const AssetLoadTimings& getLoadTimings() const { return mLoadTimings; }
+
+    /**
+     * @brief Tải trước âm thanh thắng/thua trên luồng nền (gọi khi vào màn chơi).
+     */
+    void prefetchResultSounds();
 
     bool loadMusic(const std::string& musicPath);
     void freeMusic();
@@ -45,14 +94,15 @@ public:
     TTF_Font* getFontSmall() const { return mFontSmall; }
     Mix_Music* getBackgroundMusic() const { return mBackgroundMusic; }
 
-    Mix_Chunk* getWinSound() const { return mWinSound; }
-    Mix_Chunk* getLoseSound() const { return mLoseSound; }
+    Mix_Chunk* getWinSound() { ensureResultSounds(); return mWinSound; }
+    Mix_Chunk* getLoseSound() { ensureResultSounds(); return mLoseSound; }
     Mix_Chunk* getClickBoxSound() const { return mClickBoxSound; }
 
     // === THÊM HÀM LẤY ÂM THANH NGẪU NHIÊN ===
-    Mix_Chunk* getRandomFillSound() const;
+    Mix_Chunk* getRandomFillSound(Random& rng) const;
 
-    std::string getText(const std::string& key) const;
+    // Tra chuỗi theo ngôn ngữ hiện tại: chỉ là một phép đánh chỉ số mảng, không cấp phát.
+    std::string_view getText(TextId id) const;
     void setLanguage(Language lang);
     Language getLanguage() const { return mCurrentLanguage; }
 };
\ No newline at end of file
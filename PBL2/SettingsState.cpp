@@ -14,15 +14,15 @@ void SettingsState::initButtons() {
     int sBtnW = 150, sBtnH = 50, sPad = 20;
 
     int y_pos = 165;
-    int y_increment = 95;
+    int y_increment = 80;
 
     // --- 1. Algorithm ---
     int totalW_algo = 4 * sBtnW + 3 * sPad;
     int startX_algo = (SCREEN_WIDTH - totalW_algo) / 2 + 100;
-    mUI.addButton("algo_bfs", { startX_algo, y_pos, sBtnW, sBtnH }, "BFS", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("algo_dfs", { startX_algo + sBtnW + sPad, y_pos, sBtnW, sBtnH }, "DFS", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("algo_scan", { startX_algo + 2 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, "Scanline", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("algo_uf", { startX_algo + 3 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, "UnionFind", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("algo_bfs", { startX_algo, y_pos, sBtnW, sBtnH }, TXT_ALGO_BFS, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("algo_dfs", { startX_algo + sBtnW + sPad, y_pos, sBtnW, sBtnH }, TXT_ALGO_DFS, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("algo_scan", { startX_algo + 2 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, TXT_ALGO_SCANLINE, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("algo_uf", { startX_algo + 3 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, TXT_ALGO_UNION_FIND, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
 
     y_pos += y_increment;
 
@@ -31,48 +31,58 @@ void SettingsState::initButtons() {
     int totalW_lang = 4 * langBtnW + 3 * sPad;
     int startX_lang = (SCREEN_WIDTH - totalW_lang) / 2 + 100;
 
-    mUI.addButton("lang_vi", { startX_lang, y_pos, langBtnW, sBtnH }, "settings_lang_vi", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("lang_en", { startX_lang + langBtnW + sPad, y_pos, langBtnW, sBtnH }, "settings_lang_en", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("lang_cn", { startX_lang + 2 * (langBtnW + sPad), y_pos, langBtnW, sBtnH }, "settings_lang_cn", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("lang_jp", { startX_lang + 3 * (langBtnW + sPad), y_pos, langBtnW, sBtnH }, "settings_lang_jp", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("lang_vi", { startX_lang, y_pos, langBtnW, sBtnH }, TXT_SETTINGS_LANG_VI, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("lang_en", { startX_lang + langBtnW + sPad, y_pos, langBtnW, sBtnH }, TXT_SETTINGS_LANG_EN, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("lang_cn", { startX_lang + 2 * (langBtnW + sPad), y_pos, langBtnW, sBtnH }, TXT_SETTINGS_LANG_CN, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("lang_jp", { startX_lang + 3 * (langBtnW + sPad), y_pos, langBtnW, sBtnH }, TXT_SETTINGS_LANG_JP, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
 
     y_pos += y_increment;
 
     // --- 3. Game Difficulty (Moves) ---
     int totalW_gamediff = 3 * sBtnW + 2 * sPad;
     int startX_gamediff = (SCREEN_WIDTH - totalW_gamediff) / 2 + 100;
-    mUI.addButton("diff_easy", { startX_gamediff, y_pos, sBtnW, sBtnH }, "diff_easy", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("diff_normal", { startX_gamediff + sBtnW + sPad, y_pos, sBtnW, sBtnH }, "diff_normal", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("diff_hard", { startX_gamediff + 2 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, "diff_hard", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("diff_easy", { startX_gamediff, y_pos, sBtnW, sBtnH }, TXT_DIFF_EASY, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("diff_normal", { startX_gamediff + sBtnW + sPad, y_pos, sBtnW, sBtnH }, TXT_DIFF_NORMAL, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("diff_hard", { startX_gamediff + 2 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, TXT_DIFF_HARD, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
 
     y_pos += y_increment;
 
     // --- 4. Color Difficulty (Số màu) ---
     int totalW_diff = 3 * sBtnW + 2 * sPad;
     int startX_diff = (SCREEN_WIDTH - totalW_diff) / 2 + 100;
-    mUI.addButton("color_diff_6", { startX_diff, y_pos, sBtnW, sBtnH }, "settings_diff_easy", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("color_diff_7", { startX_diff + sBtnW + sPad, y_pos, sBtnW, sBtnH }, "settings_diff_medium", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("color_diff_8", { startX_diff + 2 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, "settings_diff_hard", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("color_diff_6", { startX_diff, y_pos, sBtnW, sBtnH }, TXT_SETTINGS_DIFF_EASY, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("color_diff_7", { startX_diff + sBtnW + sPad, y_pos, sBtnW, sBtnH }, TXT_SETTINGS_DIFF_MEDIUM, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("color_diff_8", { startX_diff + 2 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, TXT_SETTINGS_DIFF_HARD, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
 
     y_pos += y_increment;
 
     // --- 5. Fill Direction ---
     int totalW_fill = 2 * sBtnW + 1 * sPad;
     int startX_fill = (SCREEN_WIDTH - totalW_fill) / 2 + 100;
-    mUI.addButton("fill_4", { startX_fill, y_pos, sBtnW, sBtnH }, "settings_fill_4", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
-    mUI.addButton("fill_8", { startX_fill + sBtnW + sPad, y_pos, sBtnW, sBtnH }, "settings_fill_8", BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("fill_4", { startX_fill, y_pos, sBtnW, sBtnH }, TXT_SETTINGS_FILL_4, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("fill_8", { startX_fill + sBtnW + sPad, y_pos, sBtnW, sBtnH }, TXT_SETTINGS_FILL_8, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
 
-    // --- 6. Back Button ---
+    y_pos += y_increment;
+
+    // --- 6. Board Shape ---
+    int totalW_shape = 4 * sBtnW + 3 * sPad;
+    int startX_shape = (SCREEN_WIDTH - totalW_shape) / 2 + 100;
+    mUI.addButton("shape_square", { startX_shape, y_pos, sBtnW, sBtnH }, TXT_SETTINGS_SHAPE_SQUARE, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("shape_torus", { startX_shape + sBtnW + sPad, y_pos, sBtnW, sBtnH }, TXT_SETTINGS_SHAPE_TORUS, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("shape_hex", { startX_shape + 2 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, TXT_SETTINGS_SHAPE_HEX, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+    mUI.addButton("shape_masked", { startX_shape + 3 * (sBtnW + sPad), y_pos, sBtnW, sBtnH }, TXT_SETTINGS_SHAPE_MASKED, BUTTON_WHITE, BUTTON_HIGHLIGHT, TEXT_BLACK);
+
+    // --- 7. Back Button ---
     y_pos += 80;
-    mUI.addButton("back", { SCREEN_WIDTH / 2 - 100, y_pos, 200, 60 }, "settings_back", BUTTON_GRAY, BUTTON_HIGHLIGHT);
+    mUI.addButton("back", { SCREEN_WIDTH / 2 - 100, y_pos, 200, 60 }, TXT_SETTINGS_BACK, BUTTON_GRAY, BUTTON_HIGHLIGHT);
     updateButtonTexts();
 }
 
 void SettingsState::updateButtonTexts() {
     mUI.updateButtonTexts();
-    mUI.getButton("color_diff_6")->setText(mGame->getResources()->getText("settings_diff_easy") + " (6)");
-    mUI.getButton("color_diff_7")->setText(mGame->getResources()->getText("settings_diff_medium") + " (7)");
-    mUI.getButton("color_diff_8")->setText(mGame->getResources()->getText("settings_diff_hard") + " (8)");
+    mUI.getButton("color_diff_6")->setText(std::string(mGame->getResources()->getText(TXT_SETTINGS_DIFF_EASY)) + " (6)");
+    mUI.getButton("color_diff_7")->setText(std::string(mGame->getResources()->getText(TXT_SETTINGS_DIFF_MEDIUM)) + " (7)");
+    mUI.getButton("color_diff_8")->setText(std::string(mGame->getResources()->getText(TXT_SETTINGS_DIFF_HARD)) + " (8)");
 }
 
 void SettingsState::handleEvents(SDL_Event& e) {
@@ -99,6 +109,10 @@ void SettingsState::handleEvents(SDL_Event& e) {
     else if (action == "color_diff_8") mGame->setNumColors(8);
     else if (action == "fill_4") mGame->setFillDirection(DIR_FOUR);
     else if (action == "fill_8") mGame->setFillDirection(DIR_EIGHT);
+    else if (action == "shape_square") mGame->setBoardShape(SHAPE_SQUARE);
+    else if (action == "shape_torus") mGame->setBoardShape(SHAPE_TORUS);
+    else if (action == "shape_hex") mGame->setBoardShape(SHAPE_HEX);
+    else if (action == "shape_masked") mGame->setBoardShape(SHAPE_MASKED);
 }
 
 void SettingsState::update() {
@@ -147,17 +161,17 @@ void SettingsState::draw(SDL_Renderer* renderer) {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
     // Vẽ tiêu đề chính
-    drawText(renderer, res->getText("settings_title"), SCREEN_WIDTH / 2, 60, fontTitle, PALETTE[2]);
+    drawText(renderer, res->getText(TXT_SETTINGS_TITLE), SCREEN_WIDTH / 2, 60, fontTitle, PALETTE[2]);
 
     int sBtnW = 150, sPad = 20;
     int y_offset = 165 + 50 / 2;
-    int y_increment = 95;
+    int y_increment = 80;
 
     // --- 1. Algorithm ---
     int totalW_algo = 4 * sBtnW + 3 * sPad;
     int startX_algo = (SCREEN_WIDTH - totalW_algo) / 2 + 100;
     int labelX = startX_algo - 20;
-    drawTextRight(renderer, res->getText("settings_algorithm"), labelX, y_offset, font, TEXT_WHITE);
+    drawTextRight(renderer, res->getText(TXT_SETTINGS_ALGORITHM), labelX, y_offset, font, TEXT_WHITE);
     AlgorithmType currentAlgo = mGame->getAlgorithm();
     mUI.getButton("algo_bfs")->draw(renderer, font, currentAlgo == ALGO_BFS);
     mUI.getButton("algo_dfs")->draw(renderer, font, currentAlgo == ALGO_DFS);
@@ -170,7 +184,7 @@ void SettingsState::draw(SDL_Renderer* renderer) {
     int totalW_lang = 4 * langBtnW + 3 * sPad;
     int startX_lang = (SCREEN_WIDTH - totalW_lang) / 2 + 100;
     labelX = startX_lang - 20;
-    drawTextRight(renderer, res->getText("settings_language"), labelX, y_offset, font, TEXT_WHITE);
+    drawTextRight(renderer, res->getText(TXT_SETTINGS_LANGUAGE), labelX, y_offset, font, TEXT_WHITE);
     Language currentLang = res->getLanguage();
     mUI.getButton("lang_vi")->draw(renderer, fontSmall, currentLang == LANG_VI);
     mUI.getButton("lang_en")->draw(renderer, fontSmall, currentLang == LANG_EN);
@@ -182,7 +196,7 @@ void SettingsState::draw(SDL_Renderer* renderer) {
     int totalW_gamediff = 3 * sBtnW + 2 * sPad;
     int startX_gamediff = (SCREEN_WIDTH - totalW_gamediff) / 2 + 100;
     labelX = startX_gamediff - 20;
-    drawTextRight(renderer, res->getText("settings_game_difficulty"), labelX, y_offset, font, TEXT_WHITE);
+    drawTextRight(renderer, res->getText(TXT_SETTINGS_GAME_DIFFICULTY), labelX, y_offset, font, TEXT_WHITE);
     GameDifficulty currentDiff = mGame->getGameDifficulty();
     mUI.getButton("diff_easy")->draw(renderer, fontSmall, currentDiff == DIFF_EASY);
     mUI.getButton("diff_normal")->draw(renderer, fontSmall, currentDiff == DIFF_NORMAL);
@@ -193,7 +207,7 @@ void SettingsState::draw(SDL_Renderer* renderer) {
     int totalW_diff = 3 * sBtnW + 2 * sPad;
     int startX_diff = (SCREEN_WIDTH - totalW_diff) / 2 + 100;
     labelX = startX_diff - 20;
-    drawTextRight(renderer, res->getText("settings_difficulty"), labelX, y_offset, font, TEXT_WHITE);
+    drawTextRight(renderer, res->getText(TXT_SETTINGS_DIFFICULTY), labelX, y_offset, font, TEXT_WHITE);
     int currentColors = mGame->getNumColors();
     mUI.getButton("color_diff_6")->draw(renderer, font, currentColors == 6);
     mUI.getButton("color_diff_7")->draw(renderer, font, currentColors == 7);
@@ -204,11 +218,23 @@ void SettingsState::draw(SDL_Renderer* renderer) {
     int totalW_fill = 2 * sBtnW + 1 * sPad;
     int startX_fill = (SCREEN_WIDTH - totalW_fill) / 2 + 100;
     labelX = startX_fill - 20;
-    drawTextRight(renderer, res->getText("settings_fill_dir"), labelX, y_offset, font, TEXT_WHITE);
+    drawTextRight(renderer, res->getText(TXT_SETTINGS_FILL_DIR), labelX, y_offset, font, TEXT_WHITE);
     FillDirection currentFill = mGame->getFillDirection();
     mUI.getButton("fill_4")->draw(renderer, font, currentFill == DIR_FOUR);
     mUI.getButton("fill_8")->draw(renderer, font, currentFill == DIR_EIGHT);
+    y_offset += y_increment;
 
-    // --- 6. Back Button ---
+    // --- 6. Board Shape ---
+    int totalW_shape = 4 * sBtnW + 3 * sPad;
+    int startX_shape = (SCREEN_WIDTH - totalW_shape) / 2 + 100;
+    labelX = startX_shape - 20;
+    drawTextRight(renderer, res->getText(TXT_SETTINGS_BOARD_SHAPE), labelX, y_offset, font, TEXT_WHITE);
+    BoardShape currentShape = mGame->getBoardShape();
+    mUI.getButton("shape_square")->draw(renderer, fontSmall, currentShape == SHAPE_SQUARE);
+    mUI.getButton("shape_torus")->draw(renderer, fontSmall, currentShape == SHAPE_TORUS);
+    mUI.getButton("shape_hex")->draw(renderer, fontSmall, currentShape == SHAPE_HEX);
+    mUI.getButton("shape_masked")->draw(renderer, fontSmall, currentShape == SHAPE_MASKED);
+
+    // --- 7. Back Button ---
     mUI.getButton("back")->draw(renderer, font);
 }
\ No newline at end of file
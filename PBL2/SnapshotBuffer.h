@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include <atomic>
+
+/**
+ * @class SnapshotBuffer
+ * @brief Bộ đệm ảnh chụp không dùng khóa giữa một luồng ghi và một luồng đọc.
+ *
+ * Luồng ghi (worker) ghi vào vùng riêng của nó rồi publish(); luồng đọc (luồng vẽ) gọi read()
+ * để lấy ảnh mới nhất. Ngoài hai vùng đọc/ghi còn một vùng trung gian được hoán đổi bằng
+ * một phép exchange nguyên tử, nên không bên nào phải chờ bên kia và luồng đọc
+ * không bao giờ thấy một ảnh đang ghi dở.
+ */
+template <typename T>
+class SnapshotBuffer {
+public:
+    SnapshotBuffer() : mMiddle(1), mWriteIndex(0), mReadIndex(2) {}
+
+    SnapshotBuffer(const SnapshotBuffer&) = delete;
+    SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+    /**
+     * @brief Vùng để luồng ghi điền ảnh tiếp theo (chứa dữ liệu cũ, phải ghi đè toàn bộ).
+     */
+    T& writeBuffer() { return mSlots[mWriteIndex]; }
+
+    /**
+     * @brief Đưa vùng vừa ghi ra cho luồng đọc và nhận lại một vùng trống để ghi tiếp.
+     */
+    void publish() {
+        mWriteIndex = mMiddle.exchange(mWriteIndex | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Lấy ảnh mới nhất đã được publish (chỉ gọi từ một luồng đọc duy nhất).
+     */
+    const T& read() {
+        if (mMiddle.load(std::memory_order_acquire) & FRESH_BIT) {
+            mReadIndex = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+        return mSlots[mReadIndex];
+    }
+
+private:
+    static const int INDEX_MASK = 3;
+    static const int FRESH_BIT = 4;
+
+    T mSlots[3];
+    std::atomic<int> mMiddle; ///< Chỉ số vùng trung gian, kèm bit báo có ảnh mới chưa đọc.
+    int mWriteIndex;          ///< Chỉ luồng ghi dùng.
+    int mReadIndex;           ///< Chỉ luồng đọc dùng.
+};
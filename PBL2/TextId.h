@@ -0,0 +1,15 @@
+﻿#pragma once
+
+/**
+ * @enum TextId
+ * @brief Mã số của mọi chuỗi hiển thị, sinh từ Translations.def.
+ *
+ * Dùng làm chỉ số trực tiếp vào bảng dịch của ResourceManager thay cho khóa chuỗi.
+ */
+enum TextId {
+#define TR(id, vi, en, cn, jp) TXT_##id,
+#include "Translations.def"
+#undef TR
+    TXT_COUNT,
+    TXT_NONE = TXT_COUNT ///< Nút tự đặt chữ (không dịch), ví dụ các nút kích thước "10", "14".
+};
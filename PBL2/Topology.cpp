@@ -0,0 +1,169 @@
+﻿#include "Topology.h"
+#include "Random.h"
+#include "Trace.h"
+#include <algorithm>
+
+namespace {
+    const int SQUARE_DX[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+    const int SQUARE_DY[8] = { 0, 0, 1, -1, 1, 1, -1, -1 };
+
+    // Lục giác xếp so le theo hàng: hai ô cùng hàng và hai ô ở mỗi hàng kề, lệch theo tính chẵn lẻ của hàng
+    const int HEX_EVEN_DX[6] = { 1, -1, -1, 0, -1, 0 };
+    const int HEX_ODD_DX[6] = { 1, -1, 0, 1, 0, 1 };
+    const int HEX_DY[6] = { 0, 0, -1, -1, 1, 1 };
+
+    const uint64_t MASK_SEED_SALT = 0x6D61736B6D61736Bull; // Lỗ được sinh từ bộ sinh riêng, không đụng tới bộ sinh của Grid
+}
+
+Topology::Topology(BoardShape shape, FillDirection dir, int dim, std::vector<unsigned char> active)
+    : mShape(shape), mDir(dir), mDim(std::max(0, dim)), mCellCount(0), mActive(std::move(active)), mCharge(MEM_GRID)
+{
+    mActive.resize((size_t)mDim * mDim, 1);
+    if (!mActive.empty()) mActive[0] = 1; // Vùng của người chơi luôn bắt đầu ở (0,0)
+    build();
+    if (hasHoles()) pruneUnreachable();
+}
+
+TopologyRef Topology::create(BoardShape shape, FillDirection dir, int dim, uint64_t seed) {
+    if (shape != SHAPE_MASKED) {
+        return TopologyRef(new Topology(shape, dir, dim, std::vector<unsigned char>()));
+    }
+
+    // Khoét vài lỗ tròn ngẫu nhiên, tránh góc (0,0) để vùng xuất phát không bị cô lập
+    std::vector<unsigned char> mask((size_t)std::max(0, dim) * std::max(0, dim), 1);
+    Random rng(seed ^ MASK_SEED_SALT);
+    int holes = std::max(1, dim / 3);
+    for (int h = 0; h < holes && dim > 0; ++h) {
+        int cx = rng.nextInt(dim), cy = rng.nextInt(dim);
+        int r = 1 + rng.nextInt(std::max(1, dim / 10));
+        if (cx - r <= 1 && cy - r <= 1) continue;
+        for (int x = std::max(0, cx - r); x <= std::min(dim - 1, cx + r); ++x) {
+            for (int y = std::max(0, cy - r); y <= std::min(dim - 1, cy + r); ++y) {
+                if ((x - cx) * (x - cx) + (y - cy) * (y - cy) <= r * r) mask[x * dim + y] = 0;
+            }
+        }
+    }
+    return createMasked(dir, dim, std::move(mask));
+}
+
+TopologyRef Topology::createMasked(FillDirection dir, int dim, std::vector<unsigned char> mask) {
+    return TopologyRef(new Topology(SHAPE_MASKED, dir, dim, std::move(mask)));
+}
+
+const char* Topology::getShapeName(BoardShape shape) {
+    switch (shape) {
+    case SHAPE_SQUARE: return "square";
+    case SHAPE_TORUS: return "torus";
+    case SHAPE_HEX: return "hex";
+    case SHAPE_MASKED: return "masked";
+    }
+    return "unknown";
+}
+
+void Topology::addNeighbors(int x, int y, std::vector<Neighbor>& out) const {
+    out.clear();
+    auto add = [&](int nx, int ny) {
+        if (mShape == SHAPE_TORUS) {
+            nx = (nx + mDim) % mDim;
+            ny = (ny + mDim) % mDim;
+        }
+        if (!isActive(nx, ny) || (nx == x && ny == y)) return;
+        out.push_back({ (uint16_t)nx, (uint16_t)ny });
+    };
+
+    if (mShape == SHAPE_HEX) {
+        const int* dx = (y & 1) ? HEX_ODD_DX : HEX_EVEN_DX;
+        for (int i = 0; i < 6; ++i) add(x + dx[i], y + HEX_DY[i]);
+    }
+    else {
+        int count = (mDir == DIR_FOUR) ? 4 : 8;
+        for (int i = 0; i < count; ++i) add(x + SQUARE_DX[i], y + SQUARE_DY[i]);
+    }
+
+    // Xếp theo thứ tự hàng để các lân cận "tiến" nằm ở đuôi; bàn hình xuyến nhỏ có thể quay vòng về cùng một ô
+    auto key = [this](const Neighbor& n) { return n.y * mDim + n.x; };
+    std::sort(out.begin(), out.end(), [&](const Neighbor& a, const Neighbor& b) { return key(a) < key(b); });
+    out.erase(std::unique(out.begin(), out.end(), [&](const Neighbor& a, const Neighbor& b) { return key(a) == key(b); }), out.end());
+}
+
+void Topology::build() {
+    TRACE_SCOPE("Topology::build");
+    const size_t total = (size_t)mDim * mDim;
+    mOffsets.assign(total + 1, 0);
+    mForward.assign(total, 0);
+    mNeighbors.clear();
+    mNeighbors.reserve(total * (mShape == SHAPE_HEX ? 6 : (mDir == DIR_FOUR ? 4 : 8)));
+    mCellCount = 0;
+
+    std::vector<Neighbor> cellNeighbors;
+    for (int x = 0; x < mDim; ++x) {
+        for (int y = 0; y < mDim; ++y) {
+            const uint32_t index = (uint32_t)(x * mDim + y);
+            mOffsets[index] = (uint32_t)mNeighbors.size();
+            mForward[index] = (uint32_t)mNeighbors.size();
+            if (!mActive[index]) continue;
+            mCellCount++;
+
+            addNeighbors(x, y, cellNeighbors);
+            for (const Neighbor& n : cellNeighbors) {
+                if (n.y * mDim + n.x < y * mDim + x) mForward[index]++;
+                mNeighbors.push_back(n);
+            }
+        }
+    }
+    mOffsets[total] = (uint32_t)mNeighbors.size();
+    mNeighbors.shrink_to_fit();
+
+    mActiveCells.clear();
+    mActiveCells.reserve(mCellCount);
+    for (int y = 0; y < mDim; ++y) {
+        for (int x = 0; x < mDim; ++x) {
+            if (mActive[x * mDim + y]) mActiveCells.push_back((uint32_t)(x * mDim + y));
+        }
+    }
+
+    mCharge.set(mActive.capacity() + (mOffsets.capacity() + mForward.capacity() + mActiveCells.capacity()) * sizeof(uint32_t)
+        + mNeighbors.capacity() * sizeof(Neighbor));
+}
+
+void Topology::pruneUnreachable() {
+    // Bỏ các ô không nối được tới (0,0): vùng của người chơi không bao giờ phủ tới chúng nên màn sẽ không thể thắng
+    std::vector<unsigned char> reached(mActive.size(), 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(mCellCount);
+    queue.push_back(0);
+    reached[0] = 1;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        for (const Neighbor* n = neighborsBegin(queue[head]); n != neighborsEnd(queue[head]); ++n) {
+            uint32_t index = (uint32_t)(n->x * mDim + n->y);
+            if (!reached[index]) {
+                reached[index] = 1;
+                queue.push_back(index);
+            }
+        }
+    }
+    if ((int)queue.size() == mCellCount) return;
+    mActive.swap(reached);
+    build();
+}
+
+int Topology::fitCellSize(int areaSize) const {
+    if (mDim <= 0) return 0;
+    if (mShape != SHAPE_HEX) return std::max(1, areaSize / mDim);
+    // Cỡ chẵn để nửa ô lệch của hàng lẻ là số nguyên
+    int size = (2 * areaSize) / (2 * mDim + 1);
+    return std::max(1, size & ~1);
+}
+
+bool Topology::cellAt(int px, int py, int cellSize, int& x, int& y) const {
+    if (cellSize <= 0 || px < 0 || py < 0) return false;
+    int row = py / cellSize;
+    if (row >= mDim) return false;
+    int shifted = px - getRowShift(row, cellSize);
+    if (shifted < 0) return false;
+    int column = shifted / cellSize;
+    if (!isActive(column, row)) return false;
+    x = column;
+    y = row;
+    return true;
+}
@@ -0,0 +1,122 @@
+﻿#pragma once
+
+#include "Constants.h"
+#include "MemoryStats.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Topology;
+
+/**
+ * @brief Topology bất biến dùng chung theo đếm tham chiếu (Grid, các AISolver, luồng gợi ý và giải thử).
+ */
+typedef std::shared_ptr<const Topology> TopologyRef;
+
+/**
+ * @class Topology
+ * @brief Cách các ô của bàn cờ nối với nhau, dựng sẵn một lần thành danh sách kề dạng CSR.
+ *
+ * Ô (x, y) có chỉ số x * dim + y như các mảng phẳng khác (Scratch, thứ tự tô của Grid). Lân cận của ô i
+ * nằm liền nhau trong mNeighbors[mOffsets[i], mOffsets[i + 1]), xếp theo thứ tự hàng (y rồi x) và đã bỏ các ô
+ * ngoài bàn cờ hoặc bị khoét, nên kernel tô màu chỉ duyệt một mảng phẳng, không kiểm tra biên hay rẽ nhánh theo hướng.
+ * Mỗi lân cận chỉ giữ tọa độ (4 byte) để danh sách nhỏ gọn; chỉ số được tính lại bằng một phép nhân.
+ *
+ * Các dạng bàn cờ:
+ * - SHAPE_SQUARE: ô vuông, 4 hoặc 8 hướng.
+ * - SHAPE_TORUS: như ô vuông nhưng mép trái nối mép phải, mép trên nối mép dưới.
+ * - SHAPE_HEX: lục giác xếp so le theo hàng (hàng lẻ lệch nửa ô sang phải), luôn 6 lân cận.
+ * - SHAPE_MASKED: ô vuông bị khoét lỗ; ô (0,0) luôn thuộc bàn cờ và các ô không nối được tới (0,0) bị bỏ.
+ */
+class Topology {
+public:
+    struct Neighbor {
+        uint16_t x, y;
+    };
+
+    /**
+     * @brief Dựng topology cho bàn cờ dim x dim. Với SHAPE_MASKED, các lỗ được sinh từ seed.
+     */
+    static TopologyRef create(BoardShape shape, FillDirection dir, int dim, uint64_t seed = 0);
+
+    /**
+     * @brief Bàn cờ ô vuông với mặt nạ tự chọn (mask[x * dim + y] khác 0 là ô thuộc bàn cờ), vd. bản đồ tự vẽ.
+     */
+    static TopologyRef createMasked(FillDirection dir, int dim, std::vector<unsigned char> mask);
+
+    static const char* getShapeName(BoardShape shape);
+
+    BoardShape getShape() const { return mShape; }
+    FillDirection getFillDirection() const { return mDir; }
+    int getDim() const { return mDim; }
+    int getCellCount() const { return mCellCount; } ///< Số ô thuộc bàn cờ (không tính lỗ).
+    bool hasHoles() const { return mCellCount < mDim * mDim; }
+    bool isActive(int x, int y) const { return x >= 0 && y >= 0 && x < mDim && y < mDim && mActive[x * mDim + y] != 0; }
+    const std::vector<unsigned char>& getMask() const { return mActive; }
+
+    /**
+     * @brief Chỉ số (x * dim + y) của ô thứ i trong các ô thuộc bàn cờ, đếm theo thứ tự hàng; 0 <= i < getCellCount().
+     */
+    uint32_t getActiveCell(int i) const { return mActiveCells[i]; }
+
+    const Neighbor* neighborsBegin(uint32_t index) const { return mNeighbors.data() + mOffsets[index]; }
+    const Neighbor* neighborsEnd(uint32_t index) const { return mNeighbors.data() + mOffsets[index + 1]; }
+
+    /**
+     * @brief Các lân cận đứng sau ô theo thứ tự hàng (đuôi của danh sách), đủ để nối mỗi cặp ô đúng một lần.
+     */
+    const Neighbor* forwardBegin(uint32_t index) const { return mNeighbors.data() + mForward[index]; }
+
+    /**
+     * @brief Hàng phía trên/dưới hàng y, -1 nếu không có (bàn cờ hình xuyến quay vòng).
+     */
+    int rowAbove(int y) const { return (y > 0) ? y - 1 : (mShape == SHAPE_TORUS ? mDim - 1 : -1); }
+    int rowBelow(int y) const { return (y < mDim - 1) ? y + 1 : (mShape == SHAPE_TORUS ? 0 : -1); }
+
+    /**
+     * @brief Ô (x, y) nối với các cột x + lo .. x + hi của hàng trên và hàng dưới (Scanline quét đúng khoảng này).
+     */
+    void getRowReach(int y, int& lo, int& hi) const {
+        if (mShape == SHAPE_HEX) { lo = (y & 1) ? 0 : -1; hi = lo + 1; }
+        else { lo = (mDir == DIR_EIGHT) ? -1 : 0; hi = -lo; }
+    }
+    bool wraps() const { return mShape == SHAPE_TORUS; }
+    bool isActiveIndex(uint32_t index) const { return mActive[index] != 0; }
+
+    // --- Hình học khi vẽ (tọa độ tính từ góc trên trái của bàn cờ) ---
+
+    /**
+     * @brief Cỡ ô lớn nhất để cả bàn cờ vừa trong ô vuông areaSize (lục giác cần thêm nửa ô chiều ngang).
+     */
+    int fitCellSize(int areaSize) const;
+
+    /**
+     * @brief Độ lệch ngang của hàng y: nửa ô với hàng lẻ của bàn lục giác, 0 với các dạng khác.
+     */
+    int getRowShift(int y, int cellSize) const { return (mShape == SHAPE_HEX && (y & 1)) ? cellSize / 2 : 0; }
+
+    int getBoardWidth(int cellSize) const { return mDim * cellSize + (mShape == SHAPE_HEX && mDim > 1 ? cellSize / 2 : 0); }
+
+    /**
+     * @brief Ô chứa điểm (px, py). false nếu điểm nằm ngoài bàn cờ hoặc rơi vào lỗ.
+     */
+    bool cellAt(int px, int py, int cellSize, int& x, int& y) const;
+
+private:
+    Topology(BoardShape shape, FillDirection dir, int dim, std::vector<unsigned char> active);
+
+    void build();
+    void addNeighbors(int x, int y, std::vector<Neighbor>& out) const;
+    void pruneUnreachable();
+
+    BoardShape mShape;
+    FillDirection mDir;
+    int mDim;
+    int mCellCount;
+    std::vector<unsigned char> mActive;  ///< 1 nếu ô thuộc bàn cờ, chỉ số x * dim + y.
+    std::vector<uint32_t> mOffsets;      ///< dim * dim + 1 phần tử.
+    std::vector<uint32_t> mForward;      ///< Vị trí lân cận đầu tiên đứng sau ô theo thứ tự hàng.
+    std::vector<uint32_t> mActiveCells;  ///< Các ô thuộc bàn cờ theo thứ tự hàng (xem getActiveCell).
+    std::vector<Neighbor> mNeighbors;
+    MemoryCharge mCharge;
+};
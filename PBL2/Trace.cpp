@@ -0,0 +1,147 @@
+﻿#include "Trace.h"
+
+#ifdef PBL2_ENABLE_TRACE
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Giới hạn để một phiên đo dài không ăn hết bộ nhớ; sự kiện vượt quá bị bỏ và được đếm lại
+    const size_t MAX_TRACE_EVENTS = 2000000;
+
+    struct TraceEvent {
+        char phase;          // 'X' khoảng thời gian, 'C' bộ đếm, 'i' tức thời, 'M' tên luồng
+        std::string name;
+        std::string argName;
+        std::string argValue;
+        double value;
+        long long ts, dur;   // micro giây tính từ start()
+        int tid;
+    };
+
+    std::mutex gMutex;
+    std::vector<TraceEvent> gEvents;
+    std::string gPath;
+    std::atomic<bool> gEnabled(false);
+    std::chrono::steady_clock::time_point gStart;
+    size_t gDropped = 0;
+
+    std::atomic<int> gNextTid(1);
+    thread_local int tThreadId = 0;
+    thread_local std::string tThreadName;
+
+    int currentTid() {
+        if (tThreadId == 0) tThreadId = gNextTid++;
+        return tThreadId;
+    }
+
+    long long microsecondsSinceStart(std::chrono::steady_clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(t - gStart).count();
+    }
+
+    void record(TraceEvent&& e) {
+        std::lock_guard<std::mutex> lock(gMutex);
+        if (gEvents.size() >= MAX_TRACE_EVENTS) { ++gDropped; return; }
+        gEvents.push_back(std::move(e));
+    }
+
+    void writeEscaped(std::ostream& out, const std::string& s) {
+        out << '"';
+        for (char c : s) {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if ((unsigned char)c < 0x20) out << ' ';
+            else out << c;
+        }
+        out << '"';
+    }
+}
+
+namespace Trace {
+    void start(const std::string& path) {
+        std::lock_guard<std::mutex> lock(gMutex);
+        gPath = path;
+        gEvents.clear();
+        gEvents.reserve(1 << 16);
+        gDropped = 0;
+        gStart = std::chrono::steady_clock::now();
+        gEnabled = true;
+    }
+
+    void stop() {
+        if (!gEnabled.exchange(false)) return;
+        std::lock_guard<std::mutex> lock(gMutex);
+
+        std::ofstream out(gPath);
+        if (!out.is_open()) {
+            std::cerr << "Không thể ghi " << gPath << "!" << std::endl;
+            return;
+        }
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (size_t i = 0; i < gEvents.size(); ++i) {
+            const TraceEvent& e = gEvents[i];
+            out << "{\"ph\":\"" << e.phase << "\",\"pid\":1,\"tid\":" << e.tid << ",\"ts\":" << e.ts << ",\"name\":";
+            writeEscaped(out, e.name);
+            if (e.phase == 'X') out << ",\"dur\":" << e.dur;
+            if (e.phase == 'i') out << ",\"s\":\"t\"";
+            if (e.phase == 'C') {
+                out << ",\"args\":{\"value\":" << e.value << "}";
+            }
+            else if (!e.argName.empty()) {
+                out << ",\"args\":{";
+                writeEscaped(out, e.argName);
+                out << ":";
+                writeEscaped(out, e.argValue);
+                out << "}";
+            }
+            out << "}" << (i + 1 < gEvents.size() ? ",\n" : "\n");
+        }
+        out << "]}\n";
+        std::cout << "Đã ghi " << gEvents.size() << " sự kiện trace vào " << gPath;
+        if (gDropped > 0) std::cout << " (bỏ " << gDropped << " sự kiện vượt giới hạn)";
+        std::cout << std::endl;
+        gEvents.clear();
+        gEvents.shrink_to_fit();
+    }
+
+    bool isEnabled() {
+        return gEnabled.load(std::memory_order_relaxed);
+    }
+
+    void setThreadName(const std::string& name) {
+        tThreadName = name;
+        if (!isEnabled()) return;
+        record({ 'M', "thread_name", "name", name, 0.0, 0, 0, currentTid() });
+    }
+
+    void counter(const char* name, double value) {
+        if (!isEnabled()) return;
+        // Mỗi luồng một đồ thị riêng, tránh bốn AI solver ghi đè lên cùng một bộ đếm
+        std::string track = tThreadName.empty() ? std::string(name) : std::string(name) + " [" + tThreadName + "]";
+        record({ 'C', std::move(track), "", "", value, microsecondsSinceStart(std::chrono::steady_clock::now()), 0, currentTid() });
+    }
+
+    void instant(const char* name) {
+        if (!isEnabled()) return;
+        record({ 'i', name, "", "", 0.0, microsecondsSinceStart(std::chrono::steady_clock::now()), 0, currentTid() });
+    }
+
+    Scope::Scope(const char* name, const char* argName, const char* argValue)
+        : mName(name), mArgName(argName), mActive(isEnabled())
+    {
+        if (!mActive) return;
+        if (argValue) mArgValue = argValue;
+        mStart = std::chrono::steady_clock::now();
+    }
+
+    Scope::~Scope() {
+        if (!mActive || !isEnabled()) return;
+        auto end = std::chrono::steady_clock::now();
+        long long ts = microsecondsSinceStart(mStart);
+        record({ 'X', mName, mArgName ? mArgName : "", std::move(mArgValue), 0.0, ts, microsecondsSinceStart(end) - ts, currentTid() });
+    }
+}
+
+#endif
@@ -0,0 +1,72 @@
+﻿#pragma once
+
+/**
+ * @file Trace.h
+ * @brief Ghi dòng thời gian dạng Chrome trace-event JSON (mở bằng chrome://tracing hoặc ui.perfetto.dev).
+ *
+ * Chỉ được biên dịch khi định nghĩa PBL2_ENABLE_TRACE (thêm vào Preprocessor Definitions của cấu hình
+ * cần đo); nếu không, mọi macro TRACE_* rỗng và không tốn gì lúc chạy. Khi bật, chạy game với
+ * `--trace [file]` để ghi (mặc định trace.json).
+ *
+ *   TRACE_SCOPE("Grid::startFloodFill");               // Khoảng thời gian tới cuối block
+ *   TRACE_SCOPE_ARG("GameState::update", "state", s);  // Kèm một tham số chuỗi
+ *   TRACE_COUNTER("fill_replay_remaining", n);         // Bộ đếm (vẽ thành đồ thị theo luồng)
+ *   TRACE_INSTANT("hint_pressed");                     // Sự kiện tức thời
+ *   TRACE_THREAD_NAME("AI BFS");                       // Đặt tên luồng hiện tại
+ */
+
+#ifdef PBL2_ENABLE_TRACE
+
+#include <chrono>
+#include <string>
+
+namespace Trace {
+    /**
+     * @brief Bắt đầu ghi sự kiện; file được ghi khi gọi stop().
+     */
+    void start(const std::string& path);
+
+    /**
+     * @brief Ngừng ghi và xuất toàn bộ sự kiện ra file JSON.
+     */
+    void stop();
+
+    bool isEnabled();
+    void setThreadName(const std::string& name);
+    void counter(const char* name, double value);
+    void instant(const char* name);
+
+    class Scope {
+    public:
+        explicit Scope(const char* name, const char* argName = nullptr, const char* argValue = nullptr);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* mName;
+        const char* mArgName;
+        std::string mArgValue;
+        std::chrono::steady_clock::time_point mStart;
+        bool mActive;
+    };
+}
+
+#define PBL2_TRACE_CONCAT_INNER(a, b) a##b
+#define PBL2_TRACE_CONCAT(a, b) PBL2_TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) Trace::Scope PBL2_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_SCOPE_ARG(name, argName, argValue) Trace::Scope PBL2_TRACE_CONCAT(traceScope_, __LINE__)(name, argName, argValue)
+#define TRACE_COUNTER(name, value) Trace::counter(name, (double)(value))
+#define TRACE_INSTANT(name) Trace::instant(name)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_ARG(name, argName, argValue) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+
+#endif
@@ -7,13 +7,13 @@ void UIManager::init(ResourceManager* resManager) {
     mResManager = resManager;
 }
 
-void UIManager::addButton(const std::string& key, const SDL_Rect& rect, const std::string& textKey,
+void UIManager::addButton(const std::string& key, const SDL_Rect& rect, TextId textId,
     SDL_Color color, SDL_Color highlightColor, SDL_Color textColor) {
     if (!mResManager) {
         return;
     }
-    std::string text = mResManager->getText(textKey);
-    mButtons[key] = Button(rect, textKey, text, color, highlightColor, textColor);
+    std::string text(mResManager->getText(textId));
+    mButtons[key] = Button(rect, textId, text, color, highlightColor, textColor);
 }
 
 std::string UIManager::handleEvents(SDL_Event& e) {
@@ -60,7 +60,8 @@ void UIManager::updateButtonTexts() {
 
     for (auto& pair : mButtons) {
         Button& button = pair.second;
-        button.setText(mResManager->getText(button.getTextKey()));
+        if (button.getTextId() == TXT_NONE) continue; // Nút tự đặt chữ, giữ nguyên
+        button.setText(std::string(mResManager->getText(button.getTextId())));
     }
 }
 
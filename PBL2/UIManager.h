@@ -14,7 +14,7 @@ public:
     UIManager();
     void init(ResourceManager* resManager);
 
-    void addButton(const std::string& key, const SDL_Rect& rect, const std::string& textKey,
+    void addButton(const std::string& key, const SDL_Rect& rect, TextId textId,
         SDL_Color color, SDL_Color highlightColor, SDL_Color textColor = TEXT_WHITE);
 
     std::string handleEvents(SDL_Event& e);
@@ -1,6 +1,9 @@
 ﻿#include <cstdlib>
-#include <ctime>
+#include <cstring>
+#include <thread>
 #include "Game.h"
+#include "LevelPack.h"
+#include "Trace.h"
 
 /**
  * @file main.cpp
@@ -12,20 +15,61 @@
 /**
  * @brief Hàm chính của chương trình.
  *
- * Khởi tạo bộ sinh số ngẫu nhiên, tạo một đối tượng `Game`,
+ * Tạo một đối tượng `Game`, đặt seed nếu có tham số `--seed <số>`,
  * khởi tạo nó, và sau đó chạy vòng lặp chính của game.
+ * Với `--build-level-pack [số màn]`, chỉ sinh file levels.pack rồi thoát (không mở cửa sổ).
+ * Với `--headless <kịch bản> [--frames-out <file csv>]`, chạy không màn hình theo kịch bản nhập liệu
+ * (xem HeadlessRunner) và ghi thời gian từng khung hình; mã thoát 1 nếu kịch bản thất bại.
+ * Nên kèm `--seed` để các lần chạy kịch bản chơi cùng bàn cờ.
+ * Với `--trace [file]` (chỉ khi biên dịch với PBL2_ENABLE_TRACE), ghi dòng thời gian Chrome trace (xem Trace.h).
  *
  * @param argc Số lượng đối số dòng lệnh.
  * @param args Mảng các đối số dòng lệnh.
  * @return 0 nếu chương trình kết thúc thành công, 1 nếu có lỗi.
  */
 int main(int argc, char* args[]) {
-    // Khởi tạo bộ sinh số ngẫu nhiên với seed là thời gian hiện tại
-    srand(static_cast<unsigned int>(time(0)));
-
     // Tạo một đối tượng Game
     Game game;
 
+    // Seed tường minh giúp tái hiện lại đúng một lượt chơi (bản đồ, sự kiện, hiệu ứng)
+    uint64_t seed = 0;
+    bool buildLevelPack = false;
+    int packLevels = 20;
+    const char* headlessScript = nullptr;
+    const char* framesOut = "frame_times.csv";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(args[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(args[i + 1], nullptr, 10);
+            game.setSeed(seed);
+        }
+        else if (std::strcmp(args[i], "--build-level-pack") == 0) {
+            buildLevelPack = true;
+            if (i + 1 < argc && args[i + 1][0] != '-') packLevels = std::atoi(args[i + 1]);
+        }
+        else if (std::strcmp(args[i], "--headless") == 0 && i + 1 < argc) {
+            headlessScript = args[++i];
+        }
+        else if (std::strcmp(args[i], "--frames-out") == 0 && i + 1 < argc) {
+            framesOut = args[++i];
+        }
+#ifdef PBL2_ENABLE_TRACE
+        else if (std::strcmp(args[i], "--trace") == 0) {
+            Trace::start(i + 1 < argc && args[i + 1][0] != '-' ? args[++i] : "trace.json");
+        }
+#endif
+    }
+
+    // Công cụ sinh level pack: giải thử từng màn song song trên mọi lõi
+    if (buildLevelPack) {
+        int threads = (int)std::thread::hardware_concurrency();
+        return LevelPack::build(LEVEL_PACK_FILE, std::max(1, packLevels), seed, threads) ? 0 : 1;
+    }
+
+    // Chạy kiểm tra thời gian khung hình trên máy không có màn hình
+    if (headlessScript && !game.enableHeadless(headlessScript, framesOut)) {
+        return 1;
+    }
+
     // Khởi tạo game. Nếu thất bại, in ra lỗi và thoát.
     if (!game.init()) {
         std::cerr << "Khởi tạo Game thất bại!" << std::endl;
@@ -34,7 +78,10 @@ int main(int argc, char* args[]) {
 
     // Bắt đầu vòng lặp chính của game
     game.run();
+#ifdef PBL2_ENABLE_TRACE
+    Trace::stop();
+#endif
 
     // Trả về 0 để báo hiệu kết thúc thành công
-    return 0;
+    return game.hasHeadlessFailed() ? 1 : 0;
 }
\ No newline at end of file